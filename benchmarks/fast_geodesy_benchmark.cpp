@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. The FastGeodesy benchmark added.
+//
+
+// The FastGeodesy benchmark: times the haversine distance, the initial bearing and the
+// conversion to ECEF for 10M random point pairs, with FastGeodesy and with the std:: functions
+// written the usual way. Each time is the best of RUNS runs. The largest difference of the
+// distances, bearings and ECEF coordinates to the std:: results is printed too, as a check that the fast
+// versions calculated the same thing (the accuracy itself is measured by
+// tests/fast_accuracy_test.cpp against long double).
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O3 -march=native -fno-trapping-math -fno-math-errno -I. benchmarks/fast_geodesy_benchmark.cpp -o fast_geodesy_benchmark
+// ./fast_geodesy_benchmark
+//
+
+#include "fast_geodesy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const std::size_t POINTS{ 10000000 };
+    const int RUNS{ 5 };
+    const double PI{ 3.141592653589793 };
+    const double RADIANS_PER_DEGREE{ PI / 180.0 };
+    const double EARTH_RADIUS{ 6371008.8 };
+    const double WGS84_A{ 6378137.0 };
+    const double WGS84_F{ 1.0 / 298.257223563 };
+    const double WGS84_E2{ WGS84_F * (2.0 - WGS84_F) };
+
+    // returns: the best time of @RUNS calls of func() in milliseconds
+    template<typename Func>
+    double BestMilliseconds(Func func)
+    {
+        double best = 0.0;
+        for (int run = 0; run < RUNS; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const auto stop = std::chrono::steady_clock::now();
+            const double milliseconds = std::chrono::duration<double, std::milli>(stop - start).count();
+            best = run == 0 || milliseconds < best ? milliseconds : best;
+        }
+        return best;
+    }
+
+    // returns: the largest absolute difference of @a and @b
+    template<typename T>
+    double MaxDifference(const std::vector<T>& a, const std::vector<double>& b)
+    {
+        double difference = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            difference = std::max(difference, std::abs(static_cast<double>(a[i]) - b[i]));
+        return difference;
+    }
+
+    // returns: the largest difference of the bearings @a and @b in degrees, modulo 360
+    template<typename T>
+    double MaxBearingDifference(const std::vector<T>& a, const std::vector<double>& b)
+    {
+        double difference = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            const double d = std::abs(static_cast<double>(a[i]) - b[i]);
+            difference = std::max(difference, std::min(d, 360.0 - d));
+        }
+        return difference;
+    }
+
+    // Times FastGeodesy<T, Degree> on the points and prints the times and the differences to the
+    // std:: results.
+    template<typename T, int Degree>
+    void BenchmarkFast(const char* name, const std::vector<double>& lat1, const std::vector<double>& lon1,
+        const std::vector<double>& lat2, const std::vector<double>& lon2, const std::vector<double>& stdDistances,
+        const std::vector<double>& stdBearings, const std::vector<double>& stdX, const std::vector<double>& stdY,
+        const std::vector<double>& stdZ)
+    {
+        const std::vector<T> fastLat1(lat1.begin(), lat1.end()), fastLon1(lon1.begin(), lon1.end());
+        const std::vector<T> fastLat2(lat2.begin(), lat2.end()), fastLon2(lon2.begin(), lon2.end());
+        const std::vector<T> heights(POINTS, static_cast<T>(100.0));
+        std::vector<T> distances(POINTS), bearings(POINTS), x(POINTS), y(POINTS), z(POINTS);
+        const FastGeodesy<T, Degree> geodesy(EARTH_RADIUS);
+        const double distanceTime = BestMilliseconds([&]()
+            {
+                geodesy.Distance(fastLat1.data(), fastLon1.data(), fastLat2.data(), fastLon2.data(), distances.data(),
+                    POINTS);
+            });
+        const double bearingTime = BestMilliseconds([&]()
+            {
+                geodesy.Bearing(fastLat1.data(), fastLon1.data(), fastLat2.data(), fastLon2.data(), bearings.data(),
+                    POINTS);
+            });
+        const double ecefTime = BestMilliseconds([&]()
+            {
+                geodesy.ToEcef(fastLat1.data(), fastLon1.data(), heights.data(), x.data(), y.data(), z.data(), POINTS);
+            });
+        std::printf("%-18s distance %8.1f ms  bearing %8.1f ms  ECEF %8.1f ms"
+            "  (differences to std: %.3g m, %.3g deg, ECEF %.3g m)\n", name, distanceTime, bearingTime, ecefTime,
+            MaxDifference(distances, stdDistances), MaxBearingDifference(bearings, stdBearings),
+            std::max({ MaxDifference(x, stdX), MaxDifference(y, stdY), MaxDifference(z, stdZ) }));
+    }
+}
+
+int main()
+{
+    // Uniform points on the sphere (uniform in sin(lat)), the same every run.
+    std::mt19937_64 generator(2026);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> lat1(POINTS), lon1(POINTS), lat2(POINTS), lon2(POINTS);
+    for (std::size_t i = 0; i < POINTS; ++i)
+    {
+        lat1[i] = std::asin(uniform(generator)) / RADIANS_PER_DEGREE;
+        lon1[i] = 180.0 * uniform(generator);
+        lat2[i] = std::asin(uniform(generator)) / RADIANS_PER_DEGREE;
+        lon2[i] = 180.0 * uniform(generator);
+    }
+
+    std::vector<double> distances(POINTS), bearings(POINTS), x(POINTS), y(POINTS), z(POINTS);
+    const double distanceTime = BestMilliseconds([&]()
+        {
+            for (std::size_t i = 0; i < POINTS; ++i)
+            {
+                const double phi1 = lat1[i] * RADIANS_PER_DEGREE, phi2 = lat2[i] * RADIANS_PER_DEGREE;
+                const double sinLat = std::sin(0.5 * (phi2 - phi1));
+                const double sinLon = std::sin(0.5 * (lon2[i] - lon1[i]) * RADIANS_PER_DEGREE);
+                const double h = sinLat * sinLat + std::cos(phi1) * std::cos(phi2) * sinLon * sinLon;
+                distances[i] = 2.0 * EARTH_RADIUS * std::asin(std::min(1.0, std::sqrt(h)));
+            }
+        });
+    const double bearingTime = BestMilliseconds([&]()
+        {
+            for (std::size_t i = 0; i < POINTS; ++i)
+            {
+                const double phi1 = lat1[i] * RADIANS_PER_DEGREE, phi2 = lat2[i] * RADIANS_PER_DEGREE;
+                const double lambda = (lon2[i] - lon1[i]) * RADIANS_PER_DEGREE;
+                const double east = std::sin(lambda) * std::cos(phi2);
+                const double north = std::cos(phi1) * std::sin(phi2) -
+                    std::sin(phi1) * std::cos(phi2) * std::cos(lambda);
+                const double bearing = std::atan2(east, north) / RADIANS_PER_DEGREE;
+                bearings[i] = bearing < 0.0 ? bearing + 360.0 : bearing;
+            }
+        });
+    const double ecefTime = BestMilliseconds([&]()
+        {
+            for (std::size_t i = 0; i < POINTS; ++i)
+            {
+                const double phi = lat1[i] * RADIANS_PER_DEGREE, lambda = lon1[i] * RADIANS_PER_DEGREE;
+                const double sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+                const double n = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sinPhi * sinPhi);
+                x[i] = (n + 100.0) * cosPhi * std::cos(lambda);
+                y[i] = (n + 100.0) * cosPhi * std::sin(lambda);
+                z[i] = (n * (1.0 - WGS84_E2) + 100.0) * sinPhi;
+            }
+        });
+    std::printf("%zu point pairs, best of %d runs\n", POINTS, RUNS);
+    std::printf("%-18s distance %8.1f ms  bearing %8.1f ms  ECEF %8.1f ms\n", "std:: (double)", distanceTime,
+        bearingTime, ecefTime);
+
+    BenchmarkFast<double, 7>("Fast double/7", lat1, lon1, lat2, lon2, distances, bearings, x, y, z);
+    BenchmarkFast<double, 9>("Fast double/9", lat1, lon1, lat2, lon2, distances, bearings, x, y, z);
+    BenchmarkFast<double, 11>("Fast double/11", lat1, lon1, lat2, lon2, distances, bearings, x, y, z);
+    BenchmarkFast<double, 15>("Fast double/15", lat1, lon1, lat2, lon2, distances, bearings, x, y, z);
+    BenchmarkFast<float, 9>("Fast float/9", lat1, lon1, lat2, lon2, distances, bearings, x, y, z);
+    return 0;
+}
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. classes FastAsin and FastAcos added.
+//
+
+#ifndef __FAST_ASIN__
+#define __FAST_ASIN__
+
+#include "fast_polynomial.h"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// FastAsin: A class to calculate mathematical asin (in radians) for a given value in [-1, 1].
+// T: The type of the calculations/return value (double/float)
+// Degree: the degree of the polynomial approximation (in x, for |x| <= 0.5).
+// Can be 5, 7, 9, 11, 15, 19 or 23 (higher is more accurate).
+// Maximum relative error for Degree 5: 7.53317e-05
+// Maximum relative error for Degree 7: 3.48035e-06
+// Maximum relative error for Degree 9: 1.77962e-07
+// Maximum relative error for Degree 11: 9.69305e-09
+// Maximum relative error for Degree 15: 3.23540e-11
+// Maximum relative error for Degree 19: 1.19285e-13
+// Maximum relative error for Degree 23: 8.91435e-16 (use with double)
+// (The absolute error of FastAcos is smaller than these.)
+// FastAsinDegree() gives the Degree whose accuracy matches a FastSin Degree.
+//   The polynomial is odd, asin(x) = x + x * x^2 * R(x^2), and only used for |x| <= 0.5. Above
+// it asin(x) = Pi/2 - 2 * asin(sqrt((1 - x) / 2)), which moves the square root singularity at
+// x = 1 out of the polynomial. Both sides are calculated and the result is selected, so there
+// are no branches and the calls can be vectorized.
+//
+// Usage example:
+// FastAsin<double, 15> fastAsin;
+// auto angle = fastAsin(0.2351);
+//
+template<typename T = double, int Degree = 7>
+class FastAsin
+{
+public:
+    // x: value in [-1, 1]
+    // returns: asin(@x) in radians
+    T operator()(T x) const;
+
+    // Batch version: calculates asin for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+    // x: value in [-0.5, 0.5]
+    // returns: the polynomial approximation of asin(@x). No argument reduction is done, so this
+    // is the building block for the classes which do their own reduction.
+    static T Polynomial(T x);
+
+private:
+    static_assert(Degree == 5 || Degree == 7 || Degree == 9 || Degree == 11 || Degree == 15 || Degree == 19 ||
+        Degree == 23, "FastAsin: Degree must be 5, 7, 9, 11, 15, 19 or 23");
+
+    // The coefficients of R(z), asin(x) = x + x * z * R(z), z = x^2.
+    struct Coefficients5
+    {
+        // degree 5 - Maximum relative error in [-0.5, 0.5]: 3.76662e-05
+        inline constexpr static double VALUES[]{ 0.165057758643328988, 0.0942986811525502638 };
+    };
+    struct Coefficients7
+    {
+        // degree 7 - Maximum relative error in [-0.5, 0.5]: 1.74020e-06
+        inline constexpr static double VALUES[]{ 0.166801259399381332, 0.0718997968757776725, 0.0641073090948175052 };
+    };
+    struct Coefficients9
+    {
+        // degree 9 - Maximum relative error in [-0.5, 0.5]: 8.89833e-08
+        inline constexpr static double VALUES[]{ 0.166655800089290007, 0.0754053123737110821, 0.0400349808927242782,
+            0.0499531242026441424 };
+    };
+    struct Coefficients11
+    {
+        // degree 11 - Maximum relative error in [-0.5, 0.5]: 4.84670e-09
+        inline constexpr static double VALUES[]{ 0.166667524820103713, 0.0749529764304791478, 0.0454703759806297174,
+            0.0241795145143563678, 0.0421663088041125572 };
+    };
+    struct Coefficients15
+    {
+        // degree 15 - Maximum relative error in [-0.5, 0.5]: 1.61782e-11
+        inline constexpr static double VALUES[]{ 0.166666671802585297, 0.0749994889772123166, 0.0446599721231852774,
+            0.0301125258983872694, 0.0246047087719930367, 0.00750948337195035361, 0.0346463165561046569 };
+    };
+    struct Coefficients19
+    {
+        // degree 19 - Maximum relative error in [-0.5, 0.5]: 5.95772e-14
+        inline constexpr static double VALUES[]{ 0.166666666696370225, 0.0749999953318181483, 0.0446431091188668741,
+            0.0303753048396116912, 0.0224704557149391514, 0.0164836367260816928, 0.0186067203038098665,
+            -0.00280721499900674169, 0.0319135497373601393 };
+    };
+    struct Coefficients23
+    {
+        // degree 23 - Maximum relative error in [-0.5, 0.5]: 2.33396e-16
+        inline constexpr static double VALUES[]{ 0.166666666666834809, 0.0749999999617006672, 0.0446428601708480671,
+            0.0303818253497192129, 0.022374870741874816, 0.0173141497143522686, 0.0143221429323837855,
+            0.00938183343727449533, 0.0182515239460460655, -0.011700704474292972, 0.0315192420222130874 };
+    };
+    using Coefficients = typename std::conditional<Degree == 5, Coefficients5,
+        typename std::conditional<Degree == 7, Coefficients7,
+        typename std::conditional<Degree == 9, Coefficients9,
+        typename std::conditional<Degree == 11, Coefficients11,
+        typename std::conditional<Degree == 15, Coefficients15,
+        typename std::conditional<Degree == 19, Coefficients19,
+        Coefficients23>::type>::type>::type>::type>::type>::type;
+
+    inline const static double PI_DIV_2{ 3.141592653589793 / 2.0 };
+};
+
+// FastAcos: A class to calculate mathematical acos (in radians) for a given value in [-1, 1].
+// T, Degree: as in FastAsin.
+//   acos(x) = Pi/2 - asin(x) for |x| <= 0.5 and 2 * asin(sqrt((1 - x) / 2)) above it, with
+// acos(-x) = Pi - acos(x), so the result is accurate also near x = 1 (small angles).
+//
+// Usage example:
+// FastAcos<float, 9> fastAcos;
+// auto angle = fastAcos(0.98f);
+//
+template<typename T = double, int Degree = 7>
+class FastAcos
+{
+public:
+    // x: value in [-1, 1]
+    // returns: acos(@x) in radians
+    T operator()(T x) const;
+
+    // Batch version: calculates acos for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+private:
+    inline const static double FAST_ACOS_PI{ 3.141592653589793 };
+    inline const static double PI_DIV_2{ FAST_ACOS_PI / 2.0 };
+};
+
+// sinDegree: FastSin Degree (7, 9, 11, 13 or 15)
+// returns: the FastAsin/FastAcos Degree with about the same maximum error
+constexpr int FastAsinDegree(const int sinDegree)
+{
+    return sinDegree == 7 ? 9 : sinDegree == 9 ? 11 : sinDegree == 11 ? 15 : sinDegree == 13 ? 19 : 23;
+}
+
+template<typename T, int Degree>
+inline T FastAsin<T, Degree>::operator()(const T x) const
+{
+    const T absX = std::abs(x);
+    const bool isLarge = absX > static_cast<T>(0.5);
+    const T s = isLarge ? std::sqrt(static_cast<T>(0.5) * (static_cast<T>(1.0) - absX)) : absX;
+    const T p = Polynomial(s);
+    const T result = isLarge ? static_cast<T>(PI_DIV_2) - static_cast<T>(2.0) * p : p;
+    return x < static_cast<T>(0.0) ? -result : result;
+}
+
+template<typename T, int Degree>
+void FastAsin<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+template<typename T, int Degree>
+inline T FastAsin<T, Degree>::Polynomial(const T x)
+{
+    const T z = x * x;
+    return x + x * z * FastPolynomial<Coefficients>::Evaluate(z);
+}
+
+template<typename T, int Degree>
+inline T FastAcos<T, Degree>::operator()(const T x) const
+{
+    const T absX = std::abs(x);
+    const bool isLarge = absX > static_cast<T>(0.5);
+    const T s = isLarge ? std::sqrt(static_cast<T>(0.5) * (static_cast<T>(1.0) - absX)) : absX;
+    const T p = FastAsin<T, Degree>::Polynomial(s);
+    const T result = isLarge ? static_cast<T>(2.0) * p : static_cast<T>(PI_DIV_2) - p;
+    return x < static_cast<T>(0.0) ? static_cast<T>(FAST_ACOS_PI) - result : result;
+}
+
+template<typename T, int Degree>
+void FastAcos<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+#endif // __FAST_ASIN__
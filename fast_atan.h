@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. classes FastAtan and FastAtan2 added.
+// 17/10/26: FastAtan::Polynomial() evaluated with FastPolynomial (fast_polynomial.h).
+//
+
+#ifndef __FAST_ATAN__
+#define __FAST_ATAN__
+
+#include "fast_polynomial.h"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// FastAtan: A class to calculate mathematical atan (in radians) for a given value.
+// T: The type of the calculations/return value (double/float)
+// Degree: the degree of the polynomial approximation (in x, for |x| <= tan(Pi/8)).
+// Can be 5, 7, 9, 11, 13, 15, 17 or 19 (higher is more accurate).
+// Maximum error for Degree 5: 8.81023e-06
+// Maximum error for Degree 7: 2.57089e-07
+// Maximum error for Degree 9: 8.06416e-09
+// Maximum error for Degree 11: 2.64391e-10
+// Maximum error for Degree 13: 8.93192e-12
+// Maximum error for Degree 15: 3.08426e-13
+// Maximum error for Degree 17: 1.10656e-14
+// Maximum error for Degree 19: 7.95371e-16 (use with double)
+// (FastAtan2 has the same maximum errors.)
+// FastAtanDegree() gives the Degree whose accuracy matches a FastSin Degree.
+//   The argument is reduced to |u| <= tan(Pi/8) with the octant identities
+//   atan(x) = Pi/4 + atan((x - 1) / (x + 1)) and atan(x) = Pi/2 - atan(1 / x)
+// so the odd polynomial atan(u) = u + u * u^2 * R(u^2) is short. Each reduction is one division
+// (numerator and denominator are selected first), and the results are selected without
+// branches, so the batch version can be vectorized (e.g. -O3 -march=native).
+//
+// Usage example:
+// FastAtan<double, 11> fastAtan;
+// auto angle = fastAtan(2.2351);
+//
+template<typename T = double, int Degree = 7>
+class FastAtan
+{
+public:
+    // x: value
+    // returns: atan(@x) in radians, in [-Pi/2, Pi/2]
+    T operator()(T x) const;
+
+    // Batch version: calculates atan for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+    // u: value in [-tan(Pi/8), tan(Pi/8)]
+    // returns: the polynomial approximation of atan(@u). No argument reduction is done, so this
+    // is the building block for the classes which do their own reduction.
+    static T Polynomial(T u);
+
+private:
+    static_assert(Degree == 5 || Degree == 7 || Degree == 9 || Degree == 11 || Degree == 13 || Degree == 15 ||
+        Degree == 17 || Degree == 19, "FastAtan: Degree must be 5, 7, 9, 11, 13, 15, 17 or 19");
+
+    // The coefficients of R(z), atan(u) = u + u * z * R(z), z = u^2.
+    struct Coefficients5
+    {
+        // degree 5 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 2.24352e-05
+        inline constexpr static double VALUES[]{ -0.331833775250225614, 0.170341778539370088 };
+    };
+    struct Coefficients7
+    {
+        // degree 7 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 6.54677e-07
+        inline constexpr static double VALUES[]{ -0.333255077850982916, 0.197141437390192452, -0.112251629368123767 };
+    };
+    struct Coefficients9
+    {
+        // degree 9 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 2.05356e-08
+        inline constexpr static double VALUES[]{ -0.333329491386457492, 0.199777100260342278, -0.138776787372411557,
+            0.0805372269761960513 };
+    };
+    struct Coefficients11
+    {
+        // degree 11 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 6.73282e-10
+        inline constexpr static double VALUES[]{ -0.333333151886283467, 0.199984715163229023, -0.142435333591370689,
+            0.105938138280469232, -0.0607822164034270819 };
+    };
+    struct Coefficients13
+    {
+        // degree 13 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 2.27459e-11
+        inline constexpr static double VALUES[]{ -0.333333324991159374, 0.199999039071961849, -0.142820077418371007,
+            0.110446915193958889, -0.0847626926370374311, 0.0474404972022384983 };
+    };
+    struct Coefficients15
+    {
+        // degree 15 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 7.85280e-13
+        inline constexpr static double VALUES[]{ -0.333333332957293221, 0.199999943267735328, -0.142854236423902745,
+            0.111040043047766226, -0.0899684463518590481, 0.0699123986595717118, -0.0379247429213824575 };
+    };
+    struct Coefficients17
+    {
+        // degree 17 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 2.75600e-14
+        inline constexpr static double VALUES[]{ -0.333333333316637127, 0.199999996806469469, -0.142856933459132056,
+            0.111104440239820139, -0.0907906169896797271, 0.0756800878617856056, -0.0588913198955419279,
+            0.0308664123658924768 };
+    };
+    struct Coefficients19
+    {
+        // degree 19 - Maximum relative error in [-tan(Pi/8), tan(Pi/8)]: 9.79777e-16
+        inline constexpr static double VALUES[]{ -0.333333333332600842, 0.199999999826835992, -0.142857128729063735,
+            0.111110544097594418, -0.0908961506873667593, 0.0767431878326115320, -0.0651024911312858684,
+            0.0503742611974235647, -0.0254743592862838964 };
+    };
+    using Coefficients = typename std::conditional<Degree == 5, Coefficients5,
+        typename std::conditional<Degree == 7, Coefficients7,
+        typename std::conditional<Degree == 9, Coefficients9,
+        typename std::conditional<Degree == 11, Coefficients11,
+        typename std::conditional<Degree == 13, Coefficients13,
+        typename std::conditional<Degree == 15, Coefficients15,
+        typename std::conditional<Degree == 17, Coefficients17,
+        Coefficients19>::type>::type>::type>::type>::type>::type>::type;
+
+    inline const static double FAST_ATAN_PI{ 3.141592653589793 };
+    inline const static double TAN_PI_DIV_8{ 0.41421356237309505 };
+    inline const static double TAN_3PI_DIV_8{ 2.414213562373095 };
+};
+
+// FastAtan2: A class to calculate mathematical atan2 (the angle of the point (x, y), in radians).
+// T, Degree: as in FastAtan.
+//   The angle of the first octant is calculated from min(|x|, |y|) / max(|x|, |y|) (reduced as
+// in FastAtan, one division) and then moved to the right octant with selects: Pi/2 - a when
+// |y| > |x|, Pi - a when x < 0 and -a when y < 0. The result has the FastAtan accuracy for all
+// angles. atan2(0, 0) is 0 and the sign of zero is not used (atan2(0, -0) is 0, not Pi).
+//
+// Usage example:
+// FastAtan2<float, 9> fastAtan2;
+// auto angle = fastAtan2(-0.5f, 0.25f);
+//
+template<typename T = double, int Degree = 7>
+class FastAtan2
+{
+public:
+    // y, x: the point, finite
+    // returns: atan2(@y, @x) in radians, in [-Pi, Pi]
+    T operator()(T y, T x) const;
+
+    // Batch version: calculates atan2 for @count points.
+    void operator()(const T* y, const T* x, T* out, std::size_t count) const;
+
+private:
+    inline const static double FAST_ATAN2_PI{ 3.141592653589793 };
+    inline const static double TAN_PI_DIV_8{ 0.41421356237309505 };
+};
+
+// sinDegree: FastSin Degree (7, 9, 11, 13 or 15)
+// returns: the FastAtan/FastAtan2 Degree with about the same maximum error
+constexpr int FastAtanDegree(const int sinDegree)
+{
+    return sinDegree == 7 ? 7 : sinDegree == 9 ? 9 : sinDegree == 11 ? 13 : sinDegree == 13 ? 17 : 19;
+}
+
+template<typename T, int Degree>
+inline T FastAtan<T, Degree>::operator()(const T x) const
+{
+    // |x| <= tan(Pi/8): atan(|x|), up to tan(3Pi/8): Pi/4 + atan((|x| - 1) / (|x| + 1)),
+    // above: Pi/2 + atan(-1 / |x|).
+    const T absX = std::abs(x);
+    const bool isMiddle = absX > static_cast<T>(TAN_PI_DIV_8);
+    const bool isLarge = absX > static_cast<T>(TAN_3PI_DIV_8);
+    const T numerator = isLarge ? static_cast<T>(-1.0) : isMiddle ? absX - static_cast<T>(1.0) : absX;
+    const T denominator = isLarge ? absX : isMiddle ? absX + static_cast<T>(1.0) : static_cast<T>(1.0);
+    const T offset = isLarge ? static_cast<T>(FAST_ATAN_PI / 2.0) :
+        isMiddle ? static_cast<T>(FAST_ATAN_PI / 4.0) : static_cast<T>(0.0);
+    const T result = offset + Polynomial(numerator / denominator);
+    return x < static_cast<T>(0.0) ? -result : result;
+}
+
+template<typename T, int Degree>
+void FastAtan<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+template<typename T, int Degree>
+inline T FastAtan<T, Degree>::Polynomial(const T u)
+{
+    const T z = u * u;
+    return u + u * z * FastPolynomial<Coefficients>::Evaluate(z);
+}
+
+template<typename T, int Degree>
+inline T FastAtan2<T, Degree>::operator()(const T y, const T x) const
+{
+    const T absX = std::abs(x), absY = std::abs(y);
+    const T smaller = absX < absY ? absX : absY;
+    const T larger = absX < absY ? absY : absX;
+    // The first octant angle atan(smaller / larger), with the reduction of FastAtan.
+    const bool isMiddle = smaller > static_cast<T>(TAN_PI_DIV_8) * larger;
+    const T numerator = isMiddle ? smaller - larger : smaller;
+    const T denominator = isMiddle ? smaller + larger : larger;
+    // Only (0, 0) has a zero denominator, and there the numerator is 0 too: divide by 1 instead.
+    const T safeDenominator = denominator == static_cast<T>(0.0) ? static_cast<T>(1.0) : denominator;
+    const T octant = (isMiddle ? static_cast<T>(FAST_ATAN2_PI / 4.0) : static_cast<T>(0.0)) +
+        FastAtan<T, Degree>::Polynomial(numerator / safeDenominator);
+    const T quadrant = absY > absX ? static_cast<T>(FAST_ATAN2_PI / 2.0) - octant : octant;
+    const T half = x < static_cast<T>(0.0) ? static_cast<T>(FAST_ATAN2_PI) - quadrant : quadrant;
+    return y < static_cast<T>(0.0) ? -half : half;
+}
+
+template<typename T, int Degree>
+void FastAtan2<T, Degree>::operator()(const T* const y, const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(y[i], x[i]);
+}
+
+#endif // __FAST_ATAN__
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. bfloat16 conversions added.
+//
+
+#ifndef __FAST_BFLOAT16__
+#define __FAST_BFLOAT16__
+
+#include <cstdint>
+#include <cstring>
+
+// bfloat16 values are stored as std::uint16_t: the upper 16 bits of a float.
+
+// value: float value
+// returns: @value rounded to the nearest bfloat16 (ties to even), NaN stays NaN
+inline std::uint16_t FastFloatToBFloat16(const float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // Rounding could turn a NaN with only low mantissa bits into infinity.
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+        return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return static_cast<std::uint16_t>(bits >> 16);
+}
+
+// value: bfloat16 value
+// returns: @value as float (exact)
+inline float FastBFloat16ToFloat(const std::uint16_t value)
+{
+    const std::uint32_t bits = static_cast<std::uint32_t>(value) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+#endif // __FAST_BFLOAT16__
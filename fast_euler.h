@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastEuler added.
+//
+
+#ifndef __FAST_EULER__
+#define __FAST_EULER__
+
+#include "fast_sin.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// Intrinsic rotation sequences (rotations about the rotating axes): XYZ means
+// R = Rx(roll) * Ry(pitch) * Rz(yaw). An extrinsic sequence (rotations about the fixed axes) is
+// the intrinsic sequence reversed, e.g. extrinsic XYZ = intrinsic ZYX (the aerospace
+// yaw-pitch-roll convention).
+enum class FastEulerOrder
+{
+    XYZ, XZY, YXZ, YZX, ZXY, ZYX
+};
+
+// FastEuler: A class to convert Euler angles (Tait-Bryan: roll about x, pitch about y and yaw
+// about z, in radians) to rotation matrices and unit quaternions in batches.
+// T, Degree: as in FastSin.
+//   The angles are processed in blocks of BLOCK_SIZE entities: one batch FastSinCos pass per
+// axis (of the full angles for the matrices and of the half angles for the quaternions) into
+// small buffers, then one pass of multiplications. All six orders use the
+// same formulas: the axes are relabeled with a permutation of the output indices, and for the
+// odd permutations (XZY, YXZ, ZYX) the sines change sign. The loops have no branches and can
+// be vectorized (see FastSinCos for the compiler options).
+//   The outputs are SoA planes of @planeStride values: element e of entity n is at
+// out[e * planeStride + n]. Matrices have 9 planes (row-major m00, m01, m02, m10, ..., m22) and
+// quaternions 4 planes (w, x, y, z). The matrices rotate column vectors (v' = R * v).
+//
+// Usage example:
+// FastEuler<float> euler(FastEulerOrder::ZYX);
+// std::vector<float> matrices(9 * count);
+// euler.Matrices(roll, pitch, yaw, count, matrices.data());
+//
+template<typename T = double, int Degree = 7>
+class FastEuler
+{
+public:
+    // order: the rotation sequence
+    // extrinsic: true if @order is an extrinsic sequence
+    explicit FastEuler(FastEulerOrder order = FastEulerOrder::ZYX, bool extrinsic = false);
+
+    // roll, pitch, yaw: @count angles in radians
+    // matrices: returns 9 planes of rotation matrix elements
+    // planeStride: distance of the planes in values, 0 = @count
+    void Matrices(const T* roll, const T* pitch, const T* yaw, std::size_t count, T* matrices,
+        std::size_t planeStride = 0) const;
+
+    // roll, pitch, yaw: @count angles in radians
+    // quaternions: returns 4 planes of quaternion elements (w, x, y, z)
+    // planeStride: distance of the planes in values, 0 = @count
+    void Quaternions(const T* roll, const T* pitch, const T* yaw, std::size_t count, T* quaternions,
+        std::size_t planeStride = 0) const;
+
+private:
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+
+    // The axes (0 = x, 1 = y, 2 = z) of the first, second and third rotation of the intrinsic sequence.
+    std::size_t m_axes[3];
+    // 1 for the even permutations of the axes, -1 for the odd ones.
+    T m_parity;
+};
+
+template<typename T, int Degree>
+FastEuler<T, Degree>::FastEuler(const FastEulerOrder order, const bool extrinsic)
+{
+    static const std::size_t AXES[6][3]{ { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+    const std::size_t* const axes = AXES[static_cast<int>(order)];
+    for (int i = 0; i < 3; ++i)
+        m_axes[i] = extrinsic ? axes[2 - i] : axes[i];
+    // The cyclic shifts of x, y, z are the even permutations.
+    m_parity = (m_axes[1] + 3 - m_axes[0]) % 3 == 1 ? static_cast<T>(1.0) : static_cast<T>(-1.0);
+}
+
+template<typename T, int Degree>
+void FastEuler<T, Degree>::Matrices(const T* const roll, const T* const pitch, const T* const yaw,
+    const std::size_t count, T* const matrices, std::size_t planeStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const T* const angles[3]{ roll, pitch, yaw };
+    const T* const sequence[3]{ angles[m_axes[0]], angles[m_axes[1]], angles[m_axes[2]] };
+    const T parity = m_parity;
+    if (planeStride == 0)
+        planeStride = count;
+    // R = Ri(a) * Rj(b) * Rk(c). The block is calculated in the order of the sequence and then
+    // copied to the planes of the relabeled axes: the nine output planes could overlap as far
+    // as the compiler knows, and it would not vectorize a loop that writes all of them.
+    T* planes[9];
+    for (int row = 0; row < 3; ++row)
+        for (int column = 0; column < 3; ++column)
+            planes[3 * row + column] = matrices + (3 * m_axes[row] + m_axes[column]) * planeStride;
+    T sinValues[3][BLOCK_SIZE], cosValues[3][BLOCK_SIZE];
+    T block[9][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        for (int axis = 0; axis < 3; ++axis)
+            sinCos(sequence[axis] + start, sinValues[axis], cosValues[axis], size);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const T sinA = parity * sinValues[0][b], sinB = parity * sinValues[1][b], sinC = parity * sinValues[2][b];
+            const T cosA = cosValues[0][b], cosB = cosValues[1][b], cosC = cosValues[2][b];
+            block[0][b] = cosB * cosC;
+            block[1][b] = -cosB * sinC;
+            block[2][b] = sinB;
+            block[3][b] = cosA * sinC + sinA * sinB * cosC;
+            block[4][b] = cosA * cosC - sinA * sinB * sinC;
+            block[5][b] = -sinA * cosB;
+            block[6][b] = sinA * sinC - cosA * sinB * cosC;
+            block[7][b] = sinA * cosC + cosA * sinB * sinC;
+            block[8][b] = cosA * cosB;
+        }
+        for (int element = 0; element < 9; ++element)
+            std::copy(block[element], block[element] + size, planes[element] + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastEuler<T, Degree>::Quaternions(const T* const roll, const T* const pitch, const T* const yaw,
+    const std::size_t count, T* const quaternions, std::size_t planeStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const T* const angles[3]{ roll, pitch, yaw };
+    const T* const sequence[3]{ angles[m_axes[0]], angles[m_axes[1]], angles[m_axes[2]] };
+    const T parity = m_parity;
+    if (planeStride == 0)
+        planeStride = count;
+    // q = qi(a) * qj(b) * qk(c), qi(a) = (cos(a/2), sin(a/2) * e_i). For the odd permutations
+    // the vector part changes sign too.
+    T* const qw = quaternions;
+    T* const qi = quaternions + (1 + m_axes[0]) * planeStride;
+    T* const qj = quaternions + (1 + m_axes[1]) * planeStride;
+    T* const qk = quaternions + (1 + m_axes[2]) * planeStride;
+    T halfAngles[BLOCK_SIZE];
+    T sinValues[3][BLOCK_SIZE], cosValues[3][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const T* const axisAngles = sequence[axis] + start;
+            for (std::size_t b = 0; b < size; ++b)
+                halfAngles[b] = static_cast<T>(0.5) * axisAngles[b];
+            sinCos(halfAngles, sinValues[axis], cosValues[axis], size);
+        }
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const std::size_t n = start + b;
+            const T sinA = parity * sinValues[0][b], sinB = parity * sinValues[1][b], sinC = parity * sinValues[2][b];
+            const T cosA = cosValues[0][b], cosB = cosValues[1][b], cosC = cosValues[2][b];
+            qw[n] = cosA * cosB * cosC - sinA * sinB * sinC;
+            qi[n] = parity * (sinA * cosB * cosC + cosA * sinB * sinC);
+            qj[n] = parity * (cosA * sinB * cosC - sinA * cosB * sinC);
+            qk[n] = parity * (cosA * cosB * sinC + sinA * sinB * cosC);
+        }
+    }
+}
+
+#endif // __FAST_EULER__
@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. classes FastExp and FastLog added (moved from FastMapProjection).
+//
+
+#ifndef __FAST_EXP_LOG__
+#define __FAST_EXP_LOG__
+
+#include "fast_polynomial.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// The bits of T used by FastExp and FastLog to build and split the exponent.
+template<typename T>
+struct FastExpLogBits
+{
+    inline const static bool IS_FLOAT{ sizeof(T) <= sizeof(float) };
+    using Bits = typename std::conditional<sizeof(T) <= sizeof(float), std::uint32_t, std::uint64_t>::type;
+    inline const static int MANTISSA_BITS{ IS_FLOAT ? 23 : 52 };
+    inline const static double EXPONENT_BIAS{ IS_FLOAT ? 127.0 : 1023.0 };
+    // x + ROUNDING_SHIFT has the integer part of x in the lowest mantissa bits
+    inline const static double ROUNDING_SHIFT{ IS_FLOAT ? 12582912.0 : 6755399441055744.0 };
+    // ln(2) split so that k * LN2_HIGH is exact
+    inline const static double LN2_HIGH{ IS_FLOAT ? 0.693359375 : 6.93147180369123816490e-01 };
+    inline const static double LN2_LOW{ IS_FLOAT ? -2.12194440e-4 : 1.90821492927058770002e-10 };
+};
+
+// FastExp: A class to calculate mathematical exp for a given value.
+// T: The type of the calculations/return value (double/float)
+// Degree: the degree of the polynomial approximation (in r, for |r| <= log(2) / 2).
+// Can be 5, 7, 9 or 11 (higher is more accurate).
+// Maximum relative error for Degree 5: 1.05e-07
+// Maximum relative error for Degree 7: 5.18e-11
+// Maximum relative error for Degree 9: 1.67e-14
+// Maximum relative error for Degree 11: 2.21e-16 (use with double)
+// (float gives about 2e-07 with Degree 5 and 1.2e-07 from Degree 7.)
+// FastExpDegree() gives the Degree whose accuracy matches a FastSin Degree.
+//   exp(x) = 2^k * exp(r) with r = x - k * log(2) in [-log(2) / 2, log(2) / 2] (log(2) split in
+// two parts as Pi in FastSinCos). 2^k is built directly from the bits of x / log(2) +
+// ROUNDING_SHIFT, which also rounds to the nearest integer, and exp(r) = 1 + r + r^2 * Q(r) is
+// evaluated with FastPolynomial (Estrin, so the long polynomials are not one dependency chain).
+// x is clamped to the range where the result is a normal number (about +-708 for double and
+// +-87 for float), so there is no overflow to infinity and no denormals. There are no branches,
+// so the batch version can be vectorized (e.g. -O3 -march=native).
+//
+// Usage example:
+// FastExp<double, 9> fastExp;
+// auto value = fastExp(-2.5);
+// fastExp(logits, values, count); // batch
+//
+template<typename T = double, int Degree = 7>
+class FastExp
+{
+public:
+    // x: value
+    // returns: exp(@x)
+    T operator()(T x) const;
+
+    // Batch version: calculates exp for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+    // r: value in [-log(2) / 2, log(2) / 2]
+    // returns: the polynomial approximation of exp(@r). No argument reduction is done.
+    static T Polynomial(T r);
+
+private:
+    static_assert(Degree == 5 || Degree == 7 || Degree == 9 || Degree == 11,
+        "FastExp: Degree must be 5, 7, 9 or 11");
+
+    // The coefficients of Q(r), exp(r) = 1 + r + r^2 * Q(r).
+    // Maximum relative errors of exp(r) in [-log(2) / 2, log(2) / 2]: 1.04638e-07,
+    // 5.17523e-11, 1.64435e-14 and 3.62003e-18.
+    struct Coefficients5
+    {
+        inline constexpr static double VALUES[]{ 0.499992317915973263, 0.166671144653919632,
+            0.0418901131504455146, 0.00831252486329639216 };
+    };
+    struct Coefficients7
+    {
+        inline constexpr static double VALUES[]{ 0.500000006764272991, 0.166666658694155503,
+            0.0416662950929323628, 0.00833349700863002218, 0.00139446486378288961, 0.000197903522265067091 };
+    };
+    struct Coefficients9
+    {
+        inline constexpr static double VALUES[]{ 0.499999999996645667, 0.166666666672647121,
+            0.0416666669620708912, 0.00833333309524051186, 0.00138888111749087141, 0.000198415389736442320,
+            0.0000248807943917027941, 2.74930811585107235e-6 };
+    };
+    struct Coefficients11
+    {
+        inline constexpr static double VALUES[]{ 0.500000000000001062, 0.166666666666664128,
+            0.0416666666665302657, 0.00833333333349433677, 0.00138888889435977802, 0.000198412695067708981,
+            0.0000248014931360976110, 2.75575862746667233e-6, 2.76302339510181689e-7, 2.50000695654314008e-8 };
+    };
+    using Coefficients = typename std::conditional<Degree == 5, Coefficients5,
+        typename std::conditional<Degree == 7, Coefficients7,
+        typename std::conditional<Degree == 9, Coefficients9, Coefficients11>::type>::type>::type;
+
+    using Bits = typename FastExpLogBits<T>::Bits;
+    inline const static double MAX_EXP_ARGUMENT{ FastExpLogBits<T>::IS_FLOAT ? 87.0 : 708.0 };
+    inline const static double LOG2E{ 1.4426950408889634 };
+};
+
+// sinDegree: FastSin Degree (7, 9, 11, 13 or 15)
+// returns: the FastExp Degree with about the same maximum error
+constexpr int FastExpDegree(const int sinDegree)
+{
+    return sinDegree == 7 ? 5 : sinDegree == 9 ? 7 : sinDegree == 11 || sinDegree == 13 ? 9 : 11;
+}
+
+// FastLog: A class to calculate mathematical log (the natural logarithm) for a given value.
+// T: The type of the calculations/return value (double/float)
+// Degree: the degree of the polynomial approximation of atanh (in s, for |s| <= 3 - 2 * sqrt(2)).
+// Can be 5, 7, 9, 11 or 13 (higher is more accurate).
+// Maximum error for Degree 5: 5.06e-08 (relative error 1.46e-07 when |log(x)| < 1)
+// Maximum error for Degree 7: 2.79e-10 (relative error 8.04e-10 when |log(x)| < 1)
+// Maximum error for Degree 9: 1.66e-12 (relative error 4.77e-12 when |log(x)| < 1)
+// Maximum error for Degree 11: 1.08e-14 (relative error 2.98e-14 when |log(x)| < 1)
+// Maximum error for Degree 13: 3.81e-16 (relative error 5.09e-16 when |log(x)| < 1, use with double)
+// (float gives about 1e-06, relative error 3e-07 when |log(x)| < 1.)
+// FastLogDegree() gives the Degree whose accuracy matches a FastSin Degree.
+//   x = m * 2^k with m in [sqrt(1/2), sqrt(2)): k and m are taken from the bits of x (k without
+// a float to integer conversion), and log(m) = 2 * atanh((m - 1) / (m + 1)), where atanh(s) =
+// s + s^3 * R(s^2) is evaluated with FastPolynomial (Horner). x must be a positive normal
+// number (no check is done for zero, denormals, infinity or NaN). There are no branches, so
+// the batch version can be vectorized (e.g. -O3 -march=native).
+//
+// Usage example:
+// FastLog<float, 7> fastLog;
+// auto value = fastLog(12.5f);
+// fastLog(features, logFeatures, count); // batch
+//
+template<typename T = double, int Degree = 7>
+class FastLog
+{
+public:
+    // x: positive value
+    // returns: log(@x)
+    T operator()(T x) const;
+
+    // Batch version: calculates log for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+    // s: value in [-(3 - 2 * sqrt(2)), 3 - 2 * sqrt(2)]
+    // returns: the polynomial approximation of atanh(@s). No argument reduction is done, so this
+    // is the building block for the classes which calculate atanh or log themselves.
+    static T Polynomial(T s);
+
+private:
+    static_assert(Degree == 5 || Degree == 7 || Degree == 9 || Degree == 11 || Degree == 13,
+        "FastLog: Degree must be 5, 7, 9, 11 or 13");
+
+    // The coefficients of R(z), atanh(s) = s + s * z * R(z), z = s^2.
+    // Maximum relative errors of atanh(s) in [-(3 - 2 * sqrt(2)), 3 - 2 * sqrt(2)]: 1.45836e-07,
+    // 8.03761e-10, 4.76092e-12, 2.94735e-14 and 1.88005e-16.
+    struct Coefficients5
+    {
+        inline constexpr static double VALUES[]{ 0.333278110069992081, 0.206009972889314014 };
+    };
+    struct Coefficients7
+    {
+        inline constexpr static double VALUES[]{ 0.333333880427474218, 0.199887870076833742,
+            0.149354686267784493 };
+    };
+    struct Coefficients9
+    {
+        inline constexpr static double VALUES[]{ 0.333333328243232288, 0.200001672672256344,
+            0.142686734854757828, 0.117907360703949808 };
+    };
+    struct Coefficients11
+    {
+        inline constexpr static double VALUES[]{ 0.333333333378843590, 0.199999978164097397,
+            0.142860539991418142, 0.110881184434512196, 0.0979173124362441694 };
+    };
+    struct Coefficients13
+    {
+        inline constexpr static double VALUES[]{ 0.333333333332937476, 0.200000000260681356,
+            0.142857085756260730, 0.111116851101152687, 0.0906184392582013330, 0.0840965021054757484 };
+    };
+    using Coefficients = typename std::conditional<Degree == 5, Coefficients5,
+        typename std::conditional<Degree == 7, Coefficients7,
+        typename std::conditional<Degree == 9, Coefficients9,
+        typename std::conditional<Degree == 11, Coefficients11, Coefficients13>::type>::type>::type>::type;
+
+    using Bits = typename FastExpLogBits<T>::Bits;
+    inline const static double SQRT2{ 1.4142135623730951 };
+};
+
+// sinDegree: FastSin Degree (7, 9, 11, 13 or 15)
+// returns: the FastLog Degree with about the same maximum error
+constexpr int FastLogDegree(const int sinDegree)
+{
+    return sinDegree == 7 ? 5 : sinDegree == 9 ? 7 : sinDegree == 11 ? 9 : sinDegree == 13 ? 11 : 13;
+}
+
+template<typename T, int Degree>
+inline T FastExp<T, Degree>::operator()(T x) const
+{
+    using Constants = FastExpLogBits<T>;
+    x = x < static_cast<T>(-MAX_EXP_ARGUMENT) ? static_cast<T>(-MAX_EXP_ARGUMENT) :
+        x > static_cast<T>(MAX_EXP_ARGUMENT) ? static_cast<T>(MAX_EXP_ARGUMENT) : x;
+    // The bits of k + ROUNDING_SHIFT + EXPONENT_BIAS have the biased exponent of 2^k in the
+    // lowest mantissa bits, shifting them up gives 2^k.
+    const T shifted = x * static_cast<T>(LOG2E) + static_cast<T>(Constants::ROUNDING_SHIFT + Constants::EXPONENT_BIAS);
+    const T k = shifted - static_cast<T>(Constants::ROUNDING_SHIFT + Constants::EXPONENT_BIAS);
+    const T r = (x - k * static_cast<T>(Constants::LN2_HIGH)) - k * static_cast<T>(Constants::LN2_LOW);
+    Bits bits;
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    bits <<= Constants::MANTISSA_BITS;
+    T scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return scale * Polynomial(r);
+}
+
+template<typename T, int Degree>
+void FastExp<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+template<typename T, int Degree>
+inline T FastExp<T, Degree>::Polynomial(const T r)
+{
+    return static_cast<T>(1.0) + r + r * r * FastPolynomial<Coefficients, FastPolynomialScheme::Estrin>::Evaluate(r);
+}
+
+template<typename T, int Degree>
+inline T FastLog<T, Degree>::operator()(const T x) const
+{
+    using Constants = FastExpLogBits<T>;
+    Bits bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const Bits mantissaMask = (static_cast<Bits>(1) << Constants::MANTISSA_BITS) - 1;
+    const Bits oneBits = static_cast<Bits>(Constants::EXPONENT_BIAS) << Constants::MANTISSA_BITS;
+    // The biased exponent as T: its bits under the mantissa of 2^MANTISSA_BITS.
+    const Bits exponentBits = (bits >> Constants::MANTISSA_BITS) |
+        ((static_cast<Bits>(Constants::EXPONENT_BIAS) + Constants::MANTISSA_BITS) << Constants::MANTISSA_BITS);
+    const Bits mantissaBits = (bits & mantissaMask) | oneBits;
+    T exponent, m;
+    std::memcpy(&exponent, &exponentBits, sizeof(exponent));
+    std::memcpy(&m, &mantissaBits, sizeof(m));
+    exponent -= static_cast<T>(Constants::ROUNDING_SHIFT / 1.5 + Constants::EXPONENT_BIAS);
+    const bool isHigh = m > static_cast<T>(SQRT2);
+    m = isHigh ? static_cast<T>(0.5) * m : m;
+    exponent = isHigh ? exponent + static_cast<T>(1.0) : exponent;
+    const T s = (m - static_cast<T>(1.0)) / (m + static_cast<T>(1.0));
+    return exponent * static_cast<T>(Constants::LN2_HIGH) + (exponent * static_cast<T>(Constants::LN2_LOW) +
+        static_cast<T>(2.0) * Polynomial(s));
+}
+
+template<typename T, int Degree>
+void FastLog<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+template<typename T, int Degree>
+inline T FastLog<T, Degree>::Polynomial(const T s)
+{
+    const T z = s * s;
+    return s + s * z * FastPolynomial<Coefficients>::Evaluate(z);
+}
+
+#endif // __FAST_EXP_LOG__
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastFourierFeatures added.
+//
+
+#ifndef __FAST_FOURIER_FEATURES__
+#define __FAST_FOURIER_FEATURES__
+
+#include "fast_sin.h"
+#include "fast_parallel.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// FastFourierFeatures: A class to calculate random Fourier features (kernel approximation):
+//   z = sqrt(2 / features) * cos(W * x + b)
+// for a batch of input vectors. W is [features x inputDim], b has @features values.
+// T, Degree: as in FastSin.
+//   The matrix multiplication is done tile by tile: a tile of ROW_TILE inputs times
+// COLUMN_TILE features is accumulated directly in the output (starting from b) and the cosine
+// is applied to it right after, while the tile is still in the cache. So the GEMM result is
+// never written out and read back. W is stored transposed ([inputDim x features]) so that the
+// innermost loop runs over contiguous features and vectorizes. The batch rows are processed in
+// parallel threads (see FastParallelFor).
+//
+// Usage example:
+// FastFourierFeatures<float> features(16, 1024, weights, offsets);
+// features(inputs, 4096, out); // out: 4096 x 1024
+//
+template<typename T = double, int Degree = 7>
+class FastFourierFeatures
+{
+public:
+    // inputDim: length of the input vectors
+    // features: number of features D
+    // weights: [features x inputDim] row-major matrix W (copied)
+    // offsets: @features values b (copied)
+    FastFourierFeatures(std::size_t inputDim, std::size_t features, const T* weights, const T* offsets);
+
+    // x: [batch x inputDim] row-major inputs
+    // batch: number of input vectors
+    // out: returns [batch x features] row-major features
+    // threads: number of threads, 0 = std::thread::hardware_concurrency()
+    void operator()(const T* x, std::size_t batch, T* out, unsigned threads = 0) const;
+
+private:
+    // Calculates the output rows [begin, end).
+    void Rows(const T* x, std::size_t begin, std::size_t end, T* out) const;
+
+    inline const static std::size_t ROW_TILE{ 4 };
+    inline const static std::size_t COLUMN_TILE{ 256 };
+
+    std::size_t m_inputDim;
+    std::size_t m_features;
+    T m_scale;
+    // W transposed: m_weights[k * features + j] = W[j][k]
+    std::vector<T> m_weights;
+    std::vector<T> m_offsets;
+};
+
+template<typename T, int Degree>
+FastFourierFeatures<T, Degree>::FastFourierFeatures(const std::size_t inputDim, const std::size_t features,
+    const T* const weights, const T* const offsets) :
+    m_inputDim{ inputDim },
+    m_features{ features },
+    m_scale{ static_cast<T>(std::sqrt(2.0 / static_cast<double>(features))) },
+    m_weights(inputDim * features),
+    m_offsets(offsets, offsets + features)
+{
+    for (std::size_t j = 0; j < features; ++j)
+        for (std::size_t k = 0; k < inputDim; ++k)
+            m_weights[k * features + j] = weights[j * inputDim + k];
+}
+
+template<typename T, int Degree>
+void FastFourierFeatures<T, Degree>::operator()(const T* const x, const std::size_t batch, T* const out,
+    const unsigned threads) const
+{
+    FastParallelFor(batch, threads, [this, x, out](const std::size_t begin, const std::size_t end)
+        {
+            Rows(x, begin, end, out);
+        });
+}
+
+template<typename T, int Degree>
+void FastFourierFeatures<T, Degree>::Rows(const T* const x, const std::size_t begin, const std::size_t end,
+    T* const out) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const std::size_t inputDim = m_inputDim;
+    const std::size_t features = m_features;
+    const T scale = m_scale;
+    const T* const weights = m_weights.data();
+    const T* const offsets = m_offsets.data();
+    for (std::size_t rowStart = begin; rowStart < end; rowStart += ROW_TILE)
+    {
+        const std::size_t rowEnd = rowStart + ROW_TILE < end ? rowStart + ROW_TILE : end;
+        for (std::size_t columnStart = 0; columnStart < features; columnStart += COLUMN_TILE)
+        {
+            const std::size_t columns = features - columnStart < COLUMN_TILE ? features - columnStart : COLUMN_TILE;
+            // W * x + b for the tile, accumulated in the output.
+            for (std::size_t row = rowStart; row < rowEnd; ++row)
+            {
+                T* const tile = out + row * features + columnStart;
+                for (std::size_t j = 0; j < columns; ++j)
+                    tile[j] = offsets[columnStart + j];
+            }
+            for (std::size_t k = 0; k < inputDim; ++k)
+            {
+                const T* const weightRow = weights + k * features + columnStart;
+                for (std::size_t row = rowStart; row < rowEnd; ++row)
+                {
+                    const T value = x[row * inputDim + k];
+                    T* const tile = out + row * features + columnStart;
+                    for (std::size_t j = 0; j < columns; ++j)
+                        tile[j] += value * weightRow[j];
+                }
+            }
+            // The cosine while the tile is still in the cache.
+            for (std::size_t row = rowStart; row < rowEnd; ++row)
+            {
+                T* const tile = out + row * features + columnStart;
+                for (std::size_t j = 0; j < columns; ++j)
+                    tile[j] = scale * sinCos.Cos(tile[j]);
+            }
+        }
+    }
+}
+
+#endif // __FAST_FOURIER_FEATURES__
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastHarmonics added.
+//
+
+#ifndef __FAST_HARMONICS__
+#define __FAST_HARMONICS__
+
+#include "fast_sin.h"
+
+#include <cstddef>
+
+// FastHarmonics: A class to calculate all harmonics sin(k*angle) and cos(k*angle), k = 1..N,
+// of one or many angles (Fourier features, additive synthesis etc.).
+// T, Degree: as in FastSin.
+//   sin(angle) and cos(angle) are calculated once with FastSinCos and the higher harmonics
+// with the Chebyshev three-term recurrence
+//   sin((k+1)*angle) = 2*cos(angle)*sin(k*angle) - sin((k-1)*angle)   (same for cos)
+// which costs one multiply-add per value. The rounding errors of the recurrence grow with k,
+// so after every @resyncInterval harmonics two consecutive harmonics are calculated again
+// directly with FastSinCos.
+//   The batch version stores the values harmonic by harmonic (values[(k-1)*count + i] is
+// harmonic k of angles[i]), so the recurrence runs over contiguous rows and vectorizes.
+//
+// Usage example:
+// FastHarmonics<double, 9> harmonics;
+// double sinValues[16], cosValues[16];
+// harmonics(0.3, 16, sinValues, cosValues); // sinValues[k-1] = sin(k*0.3)
+//
+template<typename T = double, int Degree = 7>
+class FastHarmonics
+{
+public:
+    // resyncInterval: number of harmonics between the directly calculated ones
+    explicit FastHarmonics(std::size_t resyncInterval = 32);
+
+    // angle: in radians
+    // harmonics: N
+    // sinValues, cosValues: return N values: sinValues[k-1] = sin(k*angle), k = 1..N
+    void operator()(T angle, std::size_t harmonics, T* sinValues, T* cosValues) const;
+
+    // Batch version for @count angles.
+    // sinValues, cosValues: return N*count values: sinValues[(k-1)*count + i] = sin(k*angles[i])
+    void operator()(const T* angles, std::size_t count, std::size_t harmonics, T* sinValues, T* cosValues) const;
+
+private:
+    std::size_t m_resyncInterval;
+};
+
+template<typename T, int Degree>
+FastHarmonics<T, Degree>::FastHarmonics(const std::size_t resyncInterval) :
+    m_resyncInterval{ resyncInterval > 0 ? resyncInterval : 1 }
+{
+}
+
+template<typename T, int Degree>
+void FastHarmonics<T, Degree>::operator()(const T angle, const std::size_t harmonics, T* const sinValues,
+    T* const cosValues) const
+{
+    (*this)(&angle, 1, harmonics, sinValues, cosValues);
+}
+
+template<typename T, int Degree>
+void FastHarmonics<T, Degree>::operator()(const T* const angles, const std::size_t count,
+    const std::size_t harmonics, T* const sinValues, T* const cosValues) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    for (std::size_t k = 1; k <= harmonics; ++k)
+    {
+        T* const sinRow = sinValues + (k - 1) * count;
+        T* const cosRow = cosValues + (k - 1) * count;
+        // The first two harmonics of every resync interval are calculated directly, the
+        // others with the recurrence from the two previous rows.
+        if ((k - 1) % m_resyncInterval < 2)
+        {
+            const T multiplier = static_cast<T>(k);
+            for (std::size_t i = 0; i < count; ++i)
+                sinCos(multiplier * angles[i], sinRow[i], cosRow[i]);
+            continue;
+        }
+        const T* const cos1 = cosValues;
+        const T* const sinPrev = sinRow - count;
+        const T* const cosPrev = cosRow - count;
+        const T* const sinPrev2 = sinPrev - count;
+        const T* const cosPrev2 = cosPrev - count;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const T twoCos = static_cast<T>(2.0) * cos1[i];
+            sinRow[i] = twoCos * sinPrev[i] - sinPrev2[i];
+            cosRow[i] = twoCos * cosPrev[i] - cosPrev2[i];
+        }
+    }
+}
+
+#endif // __FAST_HARMONICS__
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastSinCosInterval added.
+// 17/10/26: The quarter turn range and the padding widened with the size of the angles.
+//
+
+#ifndef __FAST_INTERVAL__
+#define __FAST_INTERVAL__
+
+#include "fast_sin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// FastSinCosInterval: A class to calculate conservative bounds [min, max] of sin and cos over
+// an angle interval [a, b] (e.g. a swept rotation in broad phase collision or culling).
+// T, Degree: as in FastSin.
+//   sin and cos are monotonic between the multiples of Pi/2, so over [a, b] they take their
+// values at a and b (one FastSinCos each) and at the multiples j * Pi/2 inside the interval,
+// j = ceil(a / (Pi/2))..floor(b / (Pi/2)). Of these only the extrema matter: sin is 1 at
+// j = 1 (mod 4) and -1 at j = 3, cos is 1 at j = 0 and -1 at j = 2. Whether the range of j has
+// a given remainder is calculated with floor, so there are no branches and the batch version
+// can be vectorized (see FastSinCos for the compiler options). An interval of a full turn or
+// more contains all four.
+//   The quarter turn numbers a / (Pi/2) and b / (Pi/2) have a rounding error that grows with
+// the angle (with float about 4e-3 quarter turns at 1e5 radians), so the range of j is widened
+// by a few ulps of them: an extremum that close to an end is counted (the bound is +-1,
+// conservative) instead of missed.
+//   The bounds are then widened by PADDING, the published maximum error of the FastSin
+// polynomial plus the rounding error of the evaluation, plus PADDING_PER_RADIAN * max(|a|, |b|)
+// for the rounding of the argument reduction of FastSinCos, and clamped to [-1, 1], so the
+// true sin and cos of every angle in [a, b] are inside them. This holds while the reduction of
+// FastSinCos is accurate: |a|, |b| < 2e5 with float and < 1.6e9 with double.
+//
+// Usage example:
+// FastSinCosInterval<float> interval;
+// float sinMin, sinMax, cosMin, cosMax;
+// interval(angle, angle + angularVelocity * dt, sinMin, sinMax, cosMin, cosMax);
+//
+template<typename T = double, int Degree = 7>
+class FastSinCosInterval
+{
+public:
+    // a, b: the angle interval in radians, a <= b
+    // sinMin, sinMax: returns the bounds of sin over [@a, @b]
+    // cosMin, cosMax: returns the bounds of cos over [@a, @b]
+    void operator()(T a, T b, T& sinMin, T& sinMax, T& cosMin, T& cosMax) const;
+
+    // Batch version: calculates the bounds for @count intervals [a[i], b[i]].
+    void operator()(const T* a, const T* b, T* sinMin, T* sinMax, T* cosMin, T* cosMax, std::size_t count) const;
+
+    // The widening of the bounds: the maximum error of FastSin<T, Degree> (the published values are
+    // rounded up) and the rounding error of T.
+    inline const static T PADDING{ static_cast<T>((Degree == 7 ? 9.39102e-07 : Degree == 9 ? 5.31400e-09 :
+        Degree == 11 ? 2.11510e-11 : Degree == 13 ? 6.26804e-14 : 4.19641e-16) +
+        8.0 * std::numeric_limits<T>::epsilon()) };
+    // The additional widening per radian of max(|a|, |b|): FastSinCos rounds k * PI_PART2 for
+    // k = angle / Pi half turns, which is twice the half ulp of it (PI_PART2 of FastSinCos).
+    inline const static T PADDING_PER_RADIAN{ static_cast<T>((sizeof(T) <= sizeof(float) ?
+        9.67502593994140625e-04 : 8.7422776573475858e-08) / 3.141592653589793 *
+        std::numeric_limits<T>::epsilon()) };
+
+private:
+    // first, last: the range of whole numbers first..last (empty if first > last)
+    // remainder: 0, 1, 2 or 3
+    // returns: true if the range has a number n with n = @remainder (mod 4)
+    static bool HasRemainder(T first, T last, T remainder);
+
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+    inline const static double FAST_SIN_PI{ 3.141592653589793 };
+    inline const static double INV_PI_DIV_2{ 2.0 / FAST_SIN_PI };
+    // The widening of the quarter turn numbers in ulps: the rounding of 2 / Pi in T and of the
+    // product are one ulp together, the rest is margin.
+    inline const static double QUARTER_TURN_ULPS{ 4.0 };
+};
+
+template<typename T, int Degree>
+inline void FastSinCosInterval<T, Degree>::operator()(const T a, const T b, T& sinMin, T& sinMax, T& cosMin,
+    T& cosMax) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    T sinA, cosA, sinB, cosB;
+    sinCos(a, sinA, cosA);
+    sinCos(b, sinB, cosB);
+    // The multiples of Pi/2 inside [a, b], widened by QUARTER_TURN_ULPS ulps of the rounded
+    // quarter turn numbers.
+    const T quarterTurnsA = a * static_cast<T>(INV_PI_DIV_2);
+    const T quarterTurnsB = b * static_cast<T>(INV_PI_DIV_2);
+    const T slack = static_cast<T>(QUARTER_TURN_ULPS) * std::numeric_limits<T>::epsilon();
+    const T first = std::ceil(quarterTurnsA - slack * std::abs(quarterTurnsA));
+    const T last = std::floor(quarterTurnsB + slack * std::abs(quarterTurnsB));
+    const T one = static_cast<T>(1.0);
+    const T upperSin = HasRemainder(first, last, static_cast<T>(1.0)) ? one : sinA > sinB ? sinA : sinB;
+    const T lowerSin = HasRemainder(first, last, static_cast<T>(3.0)) ? -one : sinA < sinB ? sinA : sinB;
+    const T upperCos = HasRemainder(first, last, static_cast<T>(0.0)) ? one : cosA > cosB ? cosA : cosB;
+    const T lowerCos = HasRemainder(first, last, static_cast<T>(2.0)) ? -one : cosA < cosB ? cosA : cosB;
+    const T absA = std::abs(a), absB = std::abs(b);
+    const T padding = PADDING + PADDING_PER_RADIAN * (absA > absB ? absA : absB);
+    sinMax = upperSin + padding > one ? one : upperSin + padding;
+    sinMin = lowerSin - padding < -one ? -one : lowerSin - padding;
+    cosMax = upperCos + padding > one ? one : upperCos + padding;
+    cosMin = lowerCos - padding < -one ? -one : lowerCos - padding;
+}
+
+template<typename T, int Degree>
+void FastSinCosInterval<T, Degree>::operator()(const T* const a, const T* const b, T* const sinMin, T* const sinMax,
+    T* const cosMin, T* const cosMax, const std::size_t count) const
+{
+    // The results go through local buffers: with six output pointers the compiler would not
+    // vectorize the loop because of the possible aliasing.
+    T sinMinBlock[BLOCK_SIZE], sinMaxBlock[BLOCK_SIZE], cosMinBlock[BLOCK_SIZE], cosMaxBlock[BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        for (std::size_t n = 0; n < size; ++n)
+            (*this)(a[start + n], b[start + n], sinMinBlock[n], sinMaxBlock[n], cosMinBlock[n], cosMaxBlock[n]);
+        std::copy(sinMinBlock, sinMinBlock + size, sinMin + start);
+        std::copy(sinMaxBlock, sinMaxBlock + size, sinMax + start);
+        std::copy(cosMinBlock, cosMinBlock + size, cosMin + start);
+        std::copy(cosMaxBlock, cosMaxBlock + size, cosMax + start);
+    }
+}
+
+template<typename T, int Degree>
+inline bool FastSinCosInterval<T, Degree>::HasRemainder(const T first, const T last, const T remainder)
+{
+    // The first number >= first with the remainder is first + ((remainder - first) mod 4).
+    const T difference = remainder - first;
+    const T offset = difference - static_cast<T>(4.0) * std::floor(difference * static_cast<T>(0.25));
+    return first + offset <= last;
+}
+
+#endif // __FAST_INTERVAL__
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastKinematics added.
+//
+
+#ifndef __FAST_KINEMATICS__
+#define __FAST_KINEMATICS__
+
+#include "fast_sin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Denavit-Hartenberg conventions:
+//   Standard (distal): A = Rz(theta) * Tz(d) * Tx(a) * Rx(alpha)
+//   Modified (proximal, Craig): A = Rx(alpha) * Tx(a) * Rz(theta) * Tz(d)
+enum class FastDhConvention
+{
+    Standard, Modified
+};
+
+// The parameters of one revolute joint. Lengths in any unit, angles in radians. The joint angle
+// is theta = q + thetaOffset, where q is the joint variable.
+struct FastDhJoint
+{
+    double a;
+    double alpha;
+    double d;
+    double thetaOffset;
+};
+
+// FastKinematics: A class to calculate the forward kinematics of a serial chain of @Joints
+// revolute joints (Denavit-Hartenberg parameters) for many joint configurations at once.
+// T, Degree: as in FastSin.
+//   The configurations are processed in blocks of BLOCK_SIZE: the pose of the block is kept in
+// local buffers and each joint is one loop over the block which calculates sin and cos of the
+// joint angle with FastSinCos and multiplies the pose with the joint transform. The joint
+// count is a template parameter, so the joint loop has a constant trip count and the compiler
+// can unroll it, and the loops over the block have no branches and vectorize (see FastSinCos
+// for the compiler options). Only the 3 x 4 affine part of the transforms is calculated, and
+// the multiplication uses the structure of the DH transform (no full matrix product).
+//   The angles are SoA planes: the angle of joint j in configuration n is at
+// angles[j * planeStride + n]. The poses are 12 planes (row-major 3 x 4: r00, r01, r02, px,
+// r10, ..., pz) of the base-to-end-effector transform; Frames() writes 12 planes for the
+// frame of each joint (joint j at plane 12 * j).
+//
+// Usage example:
+// const FastDhJoint joints[6]{ ... };
+// FastKinematics<6, float> kinematics(joints);
+// kinematics(angles, poses, 4096); // poses: 12 planes of 4096 values
+//
+template<std::size_t Joints, typename T = double, int Degree = 7>
+class FastKinematics
+{
+public:
+    // joints: the DH parameters of the @Joints joints, from the base (copied)
+    // convention: the meaning of the parameters
+    explicit FastKinematics(const FastDhJoint* joints, FastDhConvention convention = FastDhConvention::Standard);
+
+    // angles: @Joints planes of @count joint variables in radians
+    // poses: returns 12 planes of the end-effector poses
+    // planeStride: distance of the planes in values (in and out), 0 = @count
+    void operator()(const T* angles, T* poses, std::size_t count, std::size_t planeStride = 0) const;
+
+    // angles: @Joints planes of @count joint variables in radians
+    // frames: returns 12 * @Joints planes, the poses of the frames of all joints (the last is
+    // the end-effector pose)
+    // planeStride: distance of the planes in values (in and out), 0 = @count
+    void Frames(const T* angles, T* frames, std::size_t count, std::size_t planeStride = 0) const;
+
+private:
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+
+    // Calculates the poses of a block, writes the frame of each joint (@allFrames) or the last.
+    void Chain(const T* angles, T* out, std::size_t start, std::size_t size, std::size_t planeStride,
+        bool allFrames) const;
+
+    // Multiply the pose of a block (row-major 3 x 4) with the joint transform of Standard or
+    // Modified DH, @sinValues and @cosValues are sin and cos of the joint angles.
+    static void StandardJoint(T (&pose)[12][BLOCK_SIZE], const T* sinValues, const T* cosValues, std::size_t size,
+        T a, T cosAlpha, T sinAlpha, T d);
+    static void ModifiedJoint(T (&pose)[12][BLOCK_SIZE], const T* sinValues, const T* cosValues, std::size_t size,
+        T a, T cosAlpha, T sinAlpha, T d);
+
+    static_assert(Joints > 0, "FastKinematics: Joints must be at least 1");
+
+    FastDhJoint m_joints[Joints];
+    FastDhConvention m_convention;
+    double m_cosAlpha[Joints];
+    double m_sinAlpha[Joints];
+};
+
+template<std::size_t Joints, typename T, int Degree>
+FastKinematics<Joints, T, Degree>::FastKinematics(const FastDhJoint* const joints, const FastDhConvention convention) :
+    m_convention{ convention }
+{
+    std::copy(joints, joints + Joints, m_joints);
+    for (std::size_t j = 0; j < Joints; ++j)
+    {
+        m_cosAlpha[j] = std::cos(joints[j].alpha);
+        m_sinAlpha[j] = std::sin(joints[j].alpha);
+    }
+}
+
+template<std::size_t Joints, typename T, int Degree>
+void FastKinematics<Joints, T, Degree>::operator()(const T* const angles, T* const poses, const std::size_t count,
+    std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+        Chain(angles, poses, start, count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE, planeStride, false);
+}
+
+template<std::size_t Joints, typename T, int Degree>
+void FastKinematics<Joints, T, Degree>::Frames(const T* const angles, T* const frames, const std::size_t count,
+    std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+        Chain(angles, frames, start, count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE, planeStride, true);
+}
+
+template<std::size_t Joints, typename T, int Degree>
+void FastKinematics<Joints, T, Degree>::Chain(const T* const angles, T* const out, const std::size_t start,
+    const std::size_t size, const std::size_t planeStride, const bool allFrames) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    T theta[BLOCK_SIZE], sinValues[BLOCK_SIZE], cosValues[BLOCK_SIZE];
+    // The pose starts from the identity.
+    T pose[12][BLOCK_SIZE];
+    for (int element = 0; element < 12; ++element)
+        std::fill(pose[element], pose[element] + size, element % 5 == 0 ? static_cast<T>(1.0) : static_cast<T>(0.0));
+    for (std::size_t j = 0; j < Joints; ++j)
+    {
+        const FastDhJoint& joint = m_joints[j];
+        const T* const q = angles + j * planeStride + start;
+        const T thetaOffset = static_cast<T>(joint.thetaOffset);
+        for (std::size_t b = 0; b < size; ++b)
+            theta[b] = q[b] + thetaOffset;
+        sinCos(theta, sinValues, cosValues, size);
+        const T cosAlpha = static_cast<T>(m_cosAlpha[j]);
+        const T sinAlpha = static_cast<T>(m_sinAlpha[j]);
+        if (m_convention == FastDhConvention::Standard)
+            StandardJoint(pose, sinValues, cosValues, size, static_cast<T>(joint.a), cosAlpha, sinAlpha,
+                static_cast<T>(joint.d));
+        else
+            ModifiedJoint(pose, sinValues, cosValues, size, static_cast<T>(joint.a), cosAlpha, sinAlpha,
+                static_cast<T>(joint.d));
+        if (allFrames || j == Joints - 1)
+        {
+            T* const frame = out + (allFrames ? 12 * j * planeStride : 0) + start;
+            for (int element = 0; element < 12; ++element)
+                std::copy(pose[element], pose[element] + size, frame + element * planeStride);
+        }
+    }
+}
+
+template<std::size_t Joints, typename T, int Degree>
+void FastKinematics<Joints, T, Degree>::StandardJoint(T (&pose)[12][BLOCK_SIZE], const T* const sinValues,
+    const T* const cosValues, const std::size_t size, const T a, const T cosAlpha, const T sinAlpha, const T d)
+{
+    // Row (r0, r1, r2, p) * A, where A has the columns
+    //   (c, s, 0), (-s*ca, c*ca, sa), (s*sa, -c*sa, ca) and the translation (a*c, a*s, d):
+    // with x = c*r0 + s*r1 and y = c*r1 - s*r0 the row is (x, ca*y + sa*r2, ca*r2 - sa*y, p + a*x + d*r2).
+    for (std::size_t b = 0; b < size; ++b)
+    {
+        const T s = sinValues[b], c = cosValues[b];
+        for (int row = 0; row < 12; row += 4)
+        {
+            const T x = c * pose[row][b] + s * pose[row + 1][b];
+            const T y = c * pose[row + 1][b] - s * pose[row][b];
+            const T z = pose[row + 2][b];
+            pose[row][b] = x;
+            pose[row + 1][b] = cosAlpha * y + sinAlpha * z;
+            pose[row + 2][b] = cosAlpha * z - sinAlpha * y;
+            pose[row + 3][b] += a * x + d * z;
+        }
+    }
+}
+
+template<std::size_t Joints, typename T, int Degree>
+void FastKinematics<Joints, T, Degree>::ModifiedJoint(T (&pose)[12][BLOCK_SIZE], const T* const sinValues,
+    const T* const cosValues, const std::size_t size, const T a, const T cosAlpha, const T sinAlpha, const T d)
+{
+    // Row (r0, r1, r2, p) * Rx(alpha) * Tx(a) = (r0, ca*r1 + sa*r2, ca*r2 - sa*r1, p + a*r0), then
+    // * Rz(theta) * Tz(d) = (c*r0 + s*r1, c*r1 - s*r0, r2, p + d*r2).
+    for (std::size_t b = 0; b < size; ++b)
+    {
+        const T s = sinValues[b], c = cosValues[b];
+        for (int row = 0; row < 12; row += 4)
+        {
+            const T x = pose[row][b];
+            const T y = cosAlpha * pose[row + 1][b] + sinAlpha * pose[row + 2][b];
+            const T z = cosAlpha * pose[row + 2][b] - sinAlpha * pose[row + 1][b];
+            pose[row][b] = c * x + s * y;
+            pose[row + 1][b] = c * y - s * x;
+            pose[row + 2][b] = z;
+            pose[row + 3][b] += a * x + d * z;
+        }
+    }
+}
+
+#endif // __FAST_KINEMATICS__
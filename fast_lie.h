@@ -0,0 +1,512 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastLie added.
+// 17/10/26: The C and D polynomials evaluated with FastPolynomial (fast_polynomial.h).
+// 17/10/26: FastLie::So3Log() and FastLie::Se3Log() added.
+//
+
+#ifndef __FAST_LIE__
+#define __FAST_LIE__
+
+#include "fast_atan.h"
+#include "fast_sin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// FastLie: A class to calculate the exponential maps of the Lie groups SO(2)/SE(2) and
+// SO(3)/SE(3) (rotation vectors and twists to rotations and rigid motions), the logarithm maps
+// of SO(3)/SE(3) (back to rotation vectors and twists) in batches, and the coefficient
+// functions they are built from:
+//   A(theta) = sin(theta) / theta
+//   B(theta) = (1 - cos(theta)) / theta^2
+//   C(theta) = (theta - sin(theta)) / theta^3
+//   D(theta) = (1 - A / (2 * B)) / theta^2   (the SE(3) logarithm: V^-1 = I - w^/2 + D * w^2)
+// so that exp(w^) = I + A * w^ + B * w^2 (Rodrigues) and V = I + B * w^ + C * w^2.
+// T, Degree: as in FastSin.
+//   The coefficients are accurate for all angles without branches. One FastSinCos of the half
+// angle h = theta/2 gives A = (sin(h)/h) * cos(h) and B = (sin(h)/h)^2 / 2, which have no
+// cancellation (h is kept at least epsilon, and there sin(h)/h is set to exactly 1: the
+// polynomial quotient would give its leading coefficient, e.g. 0.99999906 for Degree 7).
+// C and D cancel for small angles, so below theta = 2 they are calculated with MiniMax
+// polynomials in theta^2 (as accurate as the FastSin polynomial of the same Degree) and above
+// it directly; both are calculated and the result is selected.
+//   The logarithm takes the angle from atan2(|v|, (trace(R) - 1) / 2) (FastAtan2 of the
+// matching Degree), v = (R - R^T)^v / 2 = sin(theta) * axis, so it is accurate for all angles.
+// Up to Pi/2 the rotation vector is theta / sin(theta) * v. Above it v loses the axis (it goes
+// to 0 at Pi), so the axis is taken from the column of the largest diagonal element of
+// (R + R^T) / 2 - cos(theta) * I = (1 - cos(theta)) * axis * axis^T, with the sign of v. Both
+// are calculated and the result is selected. At exactly Pi either sign is returned.
+//   Vectors and matrices are SoA planes of @planeStride values like in FastEuler: element e of
+// item n is at v[e * planeStride + n], matrices row-major (9 planes). The batches are processed
+// in blocks of BLOCK_SIZE with one short loop per step, so that the compiler can vectorize
+// them (see FastSinCos for the compiler options; GCC also needs -fno-math-errno for std::sqrt).
+//
+// Usage example:
+// FastLie<double, 15> lie;
+// lie.So3Exp(rotationVectors, rotations, count);    // 3 planes -> 9 planes
+// lie.Se3Exp(twists, rotations, translations, count); // (rho, w): 6 planes -> 9 + 3 planes
+// lie.So3Log(rotations, rotationVectors, count);    // 9 planes -> 3 planes, angles in [0, Pi]
+//
+template<typename T = double, int Degree = 7>
+class FastLie
+{
+public:
+    // theta: rotation angle in radians
+    // a, b, c: return A(theta), B(theta) and C(theta)
+    void Coefficients(T theta, T& a, T& b, T& c) const;
+
+    // Batch version: calculates the coefficients for @count angles.
+    void Coefficients(const T* theta, T* a, T* b, T* c, std::size_t count) const;
+
+    // theta: rotation angle in radians, |theta| < 2*Pi
+    // returns: D(theta)
+    T LogCoefficient(T theta) const;
+
+    // Batch version: calculates D for @count angles.
+    void LogCoefficient(const T* theta, T* d, std::size_t count) const;
+
+    // tangents: @count SE(2) tangent vectors (rho x, rho y, theta planes)
+    // out: returns the rigid motions as (cos(theta), sin(theta), t x, t y planes), t = V * rho
+    // planeStride: distance of the planes in values, 0 = @count
+    void Se2Exp(const T* tangents, T* out, std::size_t count, std::size_t planeStride = 0) const;
+
+    // rotationVectors: @count rotation vectors w (axis * angle, x, y, z planes)
+    // rotations: return the rotation matrices exp(w^) (9 planes)
+    // planeStride: distance of the planes in values, 0 = @count
+    void So3Exp(const T* rotationVectors, T* rotations, std::size_t count, std::size_t planeStride = 0) const;
+
+    // twists: @count SE(3) tangent vectors (rho x, rho y, rho z, w x, w y, w z planes)
+    // rotations: return the rotation matrices exp(w^) (9 planes)
+    // translations: return the translations V * rho (3 planes)
+    // planeStride: distance of the planes in values, 0 = @count
+    void Se3Exp(const T* twists, T* rotations, T* translations, std::size_t count,
+        std::size_t planeStride = 0) const;
+
+    // rotations: @count rotation matrices (9 planes)
+    // rotationVectors: return the rotation vectors w, exp(w^) = R, with the angle in [0, Pi]
+    // planeStride: distance of the planes in values, 0 = @count
+    void So3Log(const T* rotations, T* rotationVectors, std::size_t count, std::size_t planeStride = 0) const;
+
+    // rotations, translations: @count rigid motions (9 + 3 planes)
+    // twists: return the SE(3) tangent vectors (rho, w) (6 planes), the inverse of Se3Exp()
+    // planeStride: distance of the planes in values, 0 = @count
+    void Se3Log(const T* rotations, const T* translations, T* twists, std::size_t count,
+        std::size_t planeStride = 0) const;
+
+private:
+    // z: theta^2 in [0, 4]
+    // returns: C(theta) or D(theta) with the MiniMax polynomial
+    static T SmallC(T z);
+    static T SmallD(T z);
+
+    // The coefficients of the C(theta) and D(theta) polynomials in z = theta^2.
+    struct CCoefficients7
+    {
+        // degree 7 - Maximum relative error of C: 3.11514e-07
+        inline constexpr static double VALUES[]{ 0.166666614747651078, -0.00833293331115488021, 0.000197921779729151352,
+            -2.56016879782992254e-6 };
+    };
+    struct CCoefficients9
+    {
+        // degree 9 - Maximum relative error of C: 2.01113e-09
+        inline constexpr static double VALUES[]{ 0.166666666331478262, -0.00833332927721162512, 0.000198404744231854114,
+            -2.7502248034366549e-6, 2.34811643025355567e-8 };
+    };
+    struct CCoefficients11
+    {
+        // degree 11 - Maximum relative error of C: 9.63230e-12
+        inline constexpr static double VALUES[]{ 0.166666666665061283, -0.00833333330524327628, 0.00019841261804030494,
+            -2.7556472942605599e-6, 2.50116122748960264e-8, -1.51594888880247331e-10 };
+    };
+    struct CCoefficients13
+    {
+        // degree 13 - Maximum relative error of C: 3.55820e-14
+        inline constexpr static double VALUES[]{ 0.166666666666660736, -0.00833333333319163359, 0.000198412697856105581,
+            -2.75573109858240102e-6, 2.50515255014725855e-8, -1.60377909290146849e-10, 7.26065126405772154e-13 };
+    };
+    struct CCoefficients15
+    {
+        // degree 15 - Maximum relative error of C: 1.04456e-16
+        inline constexpr static double VALUES[]{ 0.166666666666666649, -0.00833333333333278858, 0.00019841269840988676,
+            -2.75573191684885514e-6, 2.50521029897320431e-8, -1.6058758190845031e-10, 7.63876109857983255e-13,
+            -2.68210605945107619e-15 };
+    };
+    using CCoefficients = typename std::conditional<Degree == 7, CCoefficients7,
+        typename std::conditional<Degree == 9, CCoefficients9,
+        typename std::conditional<Degree == 11, CCoefficients11,
+        typename std::conditional<Degree == 13, CCoefficients13, CCoefficients15>::type>::type>::type>::type;
+    struct DCoefficients7
+    {
+        // degree 7 - Maximum relative error of D: 6.29867e-07
+        inline constexpr static double VALUES[]{ 0.0833332808444323607, 0.0013893042479914444, 0.0000325608519926604588,
+            1.02059671313905962e-6 };
+    };
+    struct DCoefficients9
+    {
+        // degree 9 - Maximum relative error of D: 4.48717e-10
+        inline constexpr static double VALUES[]{ 0.0833333332959402686, 0.00138888955740151114,
+            0.0000330668549357539382, 8.28739459306216333e-7, 1.99327552918413381e-8, 7.25254881715723381e-10 };
+    };
+    struct DCoefficients11
+    {
+        // degree 11 - Maximum relative error of D: 1.19808e-11
+        inline constexpr static double VALUES[]{ 0.0833333333343317322, 0.00138888886456750377,
+            0.0000330688794974091556, 8.26576851008130107e-7, 2.0976605574666141e-8, 4.93079752324870546e-10,
+            1.93622136259922593e-11 };
+    };
+    struct DCoefficients13
+    {
+        // degree 13 - Maximum relative error of D: 8.54156e-15
+        inline constexpr static double VALUES[]{ 0.0833333333333340451, 0.00138888888886018553,
+            0.0000330687832589649487, 8.26719092727423226e-7, 2.08773719229798933e-8, 5.27982395017728233e-10,
+            1.35630342207969855e-11, 2.96237646043079388e-13, 1.38036077318041426e-14 };
+    };
+    struct DCoefficients15
+    {
+        // degree 15 - Maximum relative error of D: 2.28069e-16
+        inline constexpr static double VALUES[]{ 0.0833333333333333143, 0.00138888888888983552,
+            0.0000330687830610147996, 8.26719601400910899e-7, 2.08767172645928375e-8, 5.28455603479612712e-10,
+            1.33621329902407423e-11, 3.45942487171447502e-13, 7.17261043058820769e-15, 3.68570016621373192e-16 };
+    };
+    using DCoefficients = typename std::conditional<Degree == 7, DCoefficients7,
+        typename std::conditional<Degree == 9, DCoefficients9,
+        typename std::conditional<Degree == 11, DCoefficients11,
+        typename std::conditional<Degree == 13, DCoefficients13, DCoefficients15>::type>::type>::type>::type;
+
+    // Calculates A, B, C and cos(theta) of @count rotation vectors into the buffers.
+    void RotationCoefficients(const T* x, const T* y, const T* z, std::size_t count, T* a, T* b, T* c,
+        T* cosTheta) const;
+
+    // Calculates the rotation vectors (x, y, z) and their angles of @count rotation matrices
+    // (9 planes from @rotations, @planeStride apart) into the buffers.
+    void RotationLog(const T* rotations, std::size_t planeStride, std::size_t count, T* x, T* y, T* z,
+        T* theta) const;
+
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+    // The angle below which C and D are calculated with the polynomials.
+    inline const static double SMALL_THETA{ 2.0 };
+
+};
+
+template<typename T, int Degree>
+inline void FastLie<T, Degree>::Coefficients(const T theta, T& a, T& b, T& c) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const T absTheta = std::abs(theta);
+    const T halfTheta = static_cast<T>(0.5) * absTheta;
+    const T h = halfTheta > std::numeric_limits<T>::epsilon() ? halfTheta : std::numeric_limits<T>::epsilon();
+    T sinHalf, cosHalf;
+    sinCos(h, sinHalf, cosHalf);
+    const T sincHalf = halfTheta > std::numeric_limits<T>::epsilon() ? sinHalf / h : static_cast<T>(1.0);
+    a = sincHalf * cosHalf;
+    b = static_cast<T>(0.5) * sincHalf * sincHalf;
+    const T t = static_cast<T>(2.0) * h;
+    const T largeC = (t - static_cast<T>(2.0) * sinHalf * cosHalf) / (t * t * t);
+    c = absTheta < static_cast<T>(SMALL_THETA) ? SmallC(absTheta * absTheta) : largeC;
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::Coefficients(const T* const theta, T* const a, T* const b, T* const c,
+    const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        Coefficients(theta[i], a[i], b[i], c[i]);
+}
+
+template<typename T, int Degree>
+inline T FastLie<T, Degree>::LogCoefficient(const T theta) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const T absTheta = std::abs(theta);
+    const T halfTheta = static_cast<T>(0.5) * absTheta;
+    const T h = halfTheta > std::numeric_limits<T>::epsilon() ? halfTheta : std::numeric_limits<T>::epsilon();
+    T sinHalf, cosHalf;
+    sinCos(h, sinHalf, cosHalf);
+    // A / (2 * B) = h * cot(h)
+    const T t = static_cast<T>(2.0) * h;
+    const T largeD = (static_cast<T>(1.0) - h * cosHalf / sinHalf) / (t * t);
+    return absTheta < static_cast<T>(SMALL_THETA) ? SmallD(absTheta * absTheta) : largeD;
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::LogCoefficient(const T* const theta, T* const d, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        d[i] = LogCoefficient(theta[i]);
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::Se2Exp(const T* const tangents, T* const out, const std::size_t count,
+    std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    T a[BLOCK_SIZE], b[BLOCK_SIZE], c[BLOCK_SIZE];
+    T block[4][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const rhoX = tangents + start;
+        const T* const rhoY = tangents + planeStride + start;
+        const T* const theta = tangents + 2 * planeStride + start;
+        Coefficients(theta, a, b, c, size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // V = [A, -B*theta; B*theta, A], and cos(theta) = 1 - B*theta^2, sin(theta) = A*theta.
+            const T bTheta = b[i] * theta[i];
+            block[0][i] = static_cast<T>(1.0) - bTheta * theta[i];
+            block[1][i] = a[i] * theta[i];
+            block[2][i] = a[i] * rhoX[i] - bTheta * rhoY[i];
+            block[3][i] = bTheta * rhoX[i] + a[i] * rhoY[i];
+        }
+        for (int element = 0; element < 4; ++element)
+            std::copy(block[element], block[element] + size, out + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::So3Exp(const T* const rotationVectors, T* const rotations, const std::size_t count,
+    std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    T a[BLOCK_SIZE], b[BLOCK_SIZE], c[BLOCK_SIZE], cosTheta[BLOCK_SIZE];
+    T block[9][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const x = rotationVectors + start;
+        const T* const y = rotationVectors + planeStride + start;
+        const T* const z = rotationVectors + 2 * planeStride + start;
+        RotationCoefficients(x, y, z, size, a, b, c, cosTheta);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // R = cos(theta) * I + A * w^ + B * w * w^T
+            const T bx = b[i] * x[i], by = b[i] * y[i], bz = b[i] * z[i];
+            const T ax = a[i] * x[i], ay = a[i] * y[i], az = a[i] * z[i];
+            block[0][i] = cosTheta[i] + bx * x[i];
+            block[1][i] = bx * y[i] - az;
+            block[2][i] = bx * z[i] + ay;
+            block[3][i] = bx * y[i] + az;
+            block[4][i] = cosTheta[i] + by * y[i];
+            block[5][i] = by * z[i] - ax;
+            block[6][i] = bx * z[i] - ay;
+            block[7][i] = by * z[i] + ax;
+            block[8][i] = cosTheta[i] + bz * z[i];
+        }
+        for (int element = 0; element < 9; ++element)
+            std::copy(block[element], block[element] + size, rotations + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::Se3Exp(const T* const twists, T* const rotations, T* const translations,
+    const std::size_t count, std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    T a[BLOCK_SIZE], b[BLOCK_SIZE], c[BLOCK_SIZE], cosTheta[BLOCK_SIZE];
+    T block[9][BLOCK_SIZE];
+    T translationBlock[3][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const rhoX = twists + start;
+        const T* const rhoY = twists + planeStride + start;
+        const T* const rhoZ = twists + 2 * planeStride + start;
+        const T* const x = twists + 3 * planeStride + start;
+        const T* const y = twists + 4 * planeStride + start;
+        const T* const z = twists + 5 * planeStride + start;
+        RotationCoefficients(x, y, z, size, a, b, c, cosTheta);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const T bx = b[i] * x[i], by = b[i] * y[i], bz = b[i] * z[i];
+            const T ax = a[i] * x[i], ay = a[i] * y[i], az = a[i] * z[i];
+            block[0][i] = cosTheta[i] + bx * x[i];
+            block[1][i] = bx * y[i] - az;
+            block[2][i] = bx * z[i] + ay;
+            block[3][i] = bx * y[i] + az;
+            block[4][i] = cosTheta[i] + by * y[i];
+            block[5][i] = by * z[i] - ax;
+            block[6][i] = bx * z[i] - ay;
+            block[7][i] = by * z[i] + ax;
+            block[8][i] = cosTheta[i] + bz * z[i];
+            // t = V * rho = rho + B * (w x rho) + C * (w x (w x rho))
+            const T crossX = y[i] * rhoZ[i] - z[i] * rhoY[i];
+            const T crossY = z[i] * rhoX[i] - x[i] * rhoZ[i];
+            const T crossZ = x[i] * rhoY[i] - y[i] * rhoX[i];
+            const T doubleCrossX = y[i] * crossZ - z[i] * crossY;
+            const T doubleCrossY = z[i] * crossX - x[i] * crossZ;
+            const T doubleCrossZ = x[i] * crossY - y[i] * crossX;
+            translationBlock[0][i] = rhoX[i] + b[i] * crossX + c[i] * doubleCrossX;
+            translationBlock[1][i] = rhoY[i] + b[i] * crossY + c[i] * doubleCrossY;
+            translationBlock[2][i] = rhoZ[i] + b[i] * crossZ + c[i] * doubleCrossZ;
+        }
+        for (int element = 0; element < 9; ++element)
+            std::copy(block[element], block[element] + size, rotations + element * planeStride + start);
+        for (int element = 0; element < 3; ++element)
+            std::copy(translationBlock[element], translationBlock[element] + size,
+                translations + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::So3Log(const T* const rotations, T* const rotationVectors, const std::size_t count,
+    std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    T theta[BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        RotationLog(rotations + start, planeStride, size, rotationVectors + start,
+            rotationVectors + planeStride + start, rotationVectors + 2 * planeStride + start, theta);
+    }
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::Se3Log(const T* const rotations, const T* const translations, T* const twists,
+    const std::size_t count, std::size_t planeStride) const
+{
+    if (planeStride == 0)
+        planeStride = count;
+    T x[BLOCK_SIZE], y[BLOCK_SIZE], z[BLOCK_SIZE], theta[BLOCK_SIZE], d[BLOCK_SIZE];
+    T rhoBlock[3][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        RotationLog(rotations + start, planeStride, size, x, y, z, theta);
+        LogCoefficient(theta, d, size);
+        const T* const tX = translations + start;
+        const T* const tY = translations + planeStride + start;
+        const T* const tZ = translations + 2 * planeStride + start;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            // rho = V^-1 * t = t - (w x t) / 2 + D * (w x (w x t))
+            const T crossX = y[i] * tZ[i] - z[i] * tY[i];
+            const T crossY = z[i] * tX[i] - x[i] * tZ[i];
+            const T crossZ = x[i] * tY[i] - y[i] * tX[i];
+            const T doubleCrossX = y[i] * crossZ - z[i] * crossY;
+            const T doubleCrossY = z[i] * crossX - x[i] * crossZ;
+            const T doubleCrossZ = x[i] * crossY - y[i] * crossX;
+            rhoBlock[0][i] = tX[i] - static_cast<T>(0.5) * crossX + d[i] * doubleCrossX;
+            rhoBlock[1][i] = tY[i] - static_cast<T>(0.5) * crossY + d[i] * doubleCrossY;
+            rhoBlock[2][i] = tZ[i] - static_cast<T>(0.5) * crossZ + d[i] * doubleCrossZ;
+        }
+        const T* const rotationVector[3]{ x, y, z };
+        for (int element = 0; element < 3; ++element)
+        {
+            std::copy(rhoBlock[element], rhoBlock[element] + size, twists + element * planeStride + start);
+            std::copy(rotationVector[element], rotationVector[element] + size,
+                twists + (3 + element) * planeStride + start);
+        }
+    }
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::RotationLog(const T* const rotations, const std::size_t planeStride, const std::size_t count,
+    T* const x, T* const y, T* const z, T* const theta) const
+{
+    const FastAtan2<T, FastAtanDegree(Degree)> fastAtan2;
+    const T* const r00 = rotations;
+    const T* const r01 = rotations + planeStride;
+    const T* const r02 = rotations + 2 * planeStride;
+    const T* const r10 = rotations + 3 * planeStride;
+    const T* const r11 = rotations + 4 * planeStride;
+    const T* const r12 = rotations + 5 * planeStride;
+    const T* const r20 = rotations + 6 * planeStride;
+    const T* const r21 = rotations + 7 * planeStride;
+    const T* const r22 = rotations + 8 * planeStride;
+    // The results go to a local block first, so that the loop needs no aliasing checks against
+    // the nine input planes.
+    T block[4][BLOCK_SIZE];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T half = static_cast<T>(0.5);
+        const T m00 = r00[i], m01 = r01[i], m02 = r02[i];
+        const T m10 = r10[i], m11 = r11[i], m12 = r12[i];
+        const T m20 = r20[i], m21 = r21[i], m22 = r22[i];
+        // v = sin(theta) * axis
+        const T vX = half * (m21 - m12), vY = half * (m02 - m20), vZ = half * (m10 - m01);
+        const T sinTheta = std::sqrt(vX * vX + vY * vY + vZ * vZ);
+        const T cosTheta = half * (m00 + m11 + m22 - static_cast<T>(1.0));
+        const T angle = fastAtan2(sinTheta, cosTheta);
+        // Up to Pi/2 (sin(theta) = 0 only at theta = 0 there, where the limit is 1).
+        const T smallScale = sinTheta > static_cast<T>(0.0) ? angle / sinTheta : static_cast<T>(1.0);
+        // Above Pi/2: u = (1 - cos(theta)) * axis_k * axis, k the largest diagonal element.
+        const bool isFirst = (m00 >= m11) & (m00 >= m22);
+        const bool isSecond = !isFirst & (m11 >= m22);
+        const T s01 = half * (m01 + m10), s02 = half * (m02 + m20), s12 = half * (m12 + m21);
+        const T uX = isFirst ? m00 - cosTheta : isSecond ? s01 : s02;
+        const T uY = isFirst ? s01 : isSecond ? m11 - cosTheta : s12;
+        const T uZ = isFirst ? s02 : isSecond ? s12 : m22 - cosTheta;
+        const T uNorm = std::sqrt(uX * uX + uY * uY + uZ * uZ);
+        const T safeNorm = uNorm > static_cast<T>(0.0) ? uNorm : static_cast<T>(1.0);
+        const T largeScale = (uX * vX + uY * vY + uZ * vZ < static_cast<T>(0.0) ? -angle : angle) / safeNorm;
+        const bool isLarge = cosTheta < static_cast<T>(0.0);
+        block[0][i] = isLarge ? largeScale * uX : smallScale * vX;
+        block[1][i] = isLarge ? largeScale * uY : smallScale * vY;
+        block[2][i] = isLarge ? largeScale * uZ : smallScale * vZ;
+        block[3][i] = angle;
+    }
+    std::copy(block[0], block[0] + count, x);
+    std::copy(block[1], block[1] + count, y);
+    std::copy(block[2], block[2] + count, z);
+    std::copy(block[3], block[3] + count, theta);
+}
+
+template<typename T, int Degree>
+void FastLie<T, Degree>::RotationCoefficients(const T* const x, const T* const y, const T* const z,
+    const std::size_t count, T* const a, T* const b, T* const c, T* const cosTheta) const
+{
+    T theta[BLOCK_SIZE];
+    for (std::size_t i = 0; i < count; ++i)
+        theta[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+    Coefficients(theta, a, b, c, count);
+    // cos(theta) = 1 - B * theta^2, accurate also for small angles.
+    for (std::size_t i = 0; i < count; ++i)
+        cosTheta[i] = static_cast<T>(1.0) - b[i] * theta[i] * theta[i];
+}
+
+template<typename T, int Degree>
+inline T FastLie<T, Degree>::SmallC(const T z)
+{
+    return FastPolynomial<CCoefficients>::Evaluate(z);
+}
+
+template<typename T, int Degree>
+inline T FastLie<T, Degree>::SmallD(const T z)
+{
+    return FastPolynomial<DCoefficients>::Evaluate(z);
+}
+
+#endif // __FAST_LIE__
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastMixer added.
+//
+
+#ifndef __FAST_MIXER__
+#define __FAST_MIXER__
+
+#include "fast_sin.h"
+#include "fast_oscillator.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// FastMixer: A class to mix (digitally down-convert) a signal with a local oscillator:
+// out[n] = in[n] * exp(-i*2*Pi*(phase + frequency*n)), i.e. I = in*cos and Q = -in*sin for real input.
+// T, Degree: as in FastSin.
+//   The carrier is generated with FastSinCos and multiplied with the input in the same loop,
+// so there is no carrier buffer and no second pass. The phase is a 64-bit fixed point integer
+// (see FastOscillator) that is advanced exactly once per block of BLOCK_SIZE samples; inside a
+// block the angles are calculated in double from the block start, so the loop has no serial
+// dependency and can be vectorized. The phase is kept between the calls.
+//
+// Usage example:
+// FastMixer<float> mixer(-12500.0f / 250000.0f);
+// mixer.MixComplex(inI, inQ, outI, outQ, 4096);
+// mixer.MixReal(in, outIQ, 4096); // interleaved I/Q output
+//
+template<typename T = double, int Degree = 7>
+class FastMixer
+{
+public:
+    // frequency: local oscillator frequency in cycles per sample (frequency in Hz / sample rate)
+    // phase: initial phase in turns
+    explicit FastMixer(T frequency, T phase = static_cast<T>(0.0));
+
+    // in: @count real samples
+    // outI, outQ: return the @count mixed I and Q samples
+    void MixReal(const T* in, T* outI, T* outQ, std::size_t count);
+
+    // in: @count real samples
+    // outIQ: returns the 2 * @count mixed samples, I and Q interleaved
+    void MixReal(const T* in, T* outIQ, std::size_t count);
+
+    // inI, inQ: @count complex samples in split format
+    // outI, outQ: return the @count mixed samples. Can be the same as the input.
+    void MixComplex(const T* inI, const T* inQ, T* outI, T* outQ, std::size_t count);
+
+    // inIQ: @count complex samples, I and Q interleaved
+    // outIQ: returns the 2 * @count mixed samples. Can be the same as @inIQ.
+    void MixComplex(const T* inIQ, T* outIQ, std::size_t count);
+
+    // returns: the current phase in turns, [0, 1)
+    T Phase() const;
+
+    // phase: new phase in turns
+    void SetPhase(T phase);
+
+private:
+    // Calls func(i, cos, sin) of the carrier for every sample and advances the phase.
+    template<typename Func>
+    void Process(Func func, std::size_t count);
+
+    inline const static std::size_t BLOCK_SIZE{ 256 };
+
+    std::uint64_t m_phase;
+    std::uint64_t m_increment;
+    double m_incrementHalfTurns;
+};
+
+template<typename T, int Degree>
+FastMixer<T, Degree>::FastMixer(const T frequency, const T phase) :
+    m_phase{ FastOscillator<T, Degree>::ToFixedPoint(phase) },
+    m_increment{ FastOscillator<T, Degree>::ToFixedPoint(frequency) },
+    m_incrementHalfTurns{ FastOscillator<double, Degree>::ToHalfTurns(m_increment) }
+{
+}
+
+template<typename T, int Degree>
+void FastMixer<T, Degree>::MixReal(const T* const in, T* const outI, T* const outQ, const std::size_t count)
+{
+    Process([in, outI, outQ](const std::size_t i, const T cosValue, const T sinValue)
+        {
+            outI[i] = in[i] * cosValue;
+            outQ[i] = -in[i] * sinValue;
+        }, count);
+}
+
+template<typename T, int Degree>
+void FastMixer<T, Degree>::MixReal(const T* const in, T* const outIQ, const std::size_t count)
+{
+    Process([in, outIQ](const std::size_t i, const T cosValue, const T sinValue)
+        {
+            outIQ[2 * i] = in[i] * cosValue;
+            outIQ[2 * i + 1] = -in[i] * sinValue;
+        }, count);
+}
+
+template<typename T, int Degree>
+void FastMixer<T, Degree>::MixComplex(const T* const inI, const T* const inQ, T* const outI, T* const outQ,
+    const std::size_t count)
+{
+    Process([inI, inQ, outI, outQ](const std::size_t i, const T cosValue, const T sinValue)
+        {
+            // (I + iQ) * (cos - i*sin)
+            const T valueI = inI[i];
+            const T valueQ = inQ[i];
+            outI[i] = valueI * cosValue + valueQ * sinValue;
+            outQ[i] = valueQ * cosValue - valueI * sinValue;
+        }, count);
+}
+
+template<typename T, int Degree>
+void FastMixer<T, Degree>::MixComplex(const T* const inIQ, T* const outIQ, const std::size_t count)
+{
+    Process([inIQ, outIQ](const std::size_t i, const T cosValue, const T sinValue)
+        {
+            const T valueI = inIQ[2 * i];
+            const T valueQ = inIQ[2 * i + 1];
+            outIQ[2 * i] = valueI * cosValue + valueQ * sinValue;
+            outIQ[2 * i + 1] = valueQ * cosValue - valueI * sinValue;
+        }, count);
+}
+
+template<typename T, int Degree>
+T FastMixer<T, Degree>::Phase() const
+{
+    const double halfTurns = FastOscillator<double, Degree>::ToHalfTurns(m_phase);
+    // A phase just below a full turn rounds to 1 in T: that is the same angle as 0.
+    const T phase = static_cast<T>(halfTurns < 0.0 ? 0.5 * halfTurns + 1.0 : 0.5 * halfTurns);
+    return phase < static_cast<T>(1.0) ? phase : static_cast<T>(0.0);
+}
+
+template<typename T, int Degree>
+void FastMixer<T, Degree>::SetPhase(const T phase)
+{
+    m_phase = FastOscillator<T, Degree>::ToFixedPoint(phase);
+}
+
+template<typename T, int Degree>
+template<typename Func>
+void FastMixer<T, Degree>::Process(Func func, const std::size_t count)
+{
+    const FastSinCos<T, Degree> sinCos;
+    // A local copy, so that the compiler knows the output writes do not change it.
+    const double incrementHalfTurns = m_incrementHalfTurns;
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t blockCount = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const double startHalfTurns = FastOscillator<double, Degree>::ToHalfTurns(m_phase);
+        for (std::size_t i = 0; i < blockCount; ++i)
+        {
+            // Wrap to [-1, 1) half turns in double before converting, so that float keeps its accuracy.
+            // The index goes through int because 64-bit integer to double conversion does not vectorize.
+            double halfTurns = startHalfTurns + static_cast<double>(static_cast<int>(i)) * incrementHalfTurns;
+            halfTurns -= 2.0 * std::floor(0.5 * halfTurns + 0.5);
+            T sinValue, cosValue;
+            sinCos.SinCosPi(static_cast<T>(halfTurns), sinValue, cosValue);
+            func(start + i, cosValue, sinValue);
+        }
+        m_phase += static_cast<std::uint64_t>(blockCount) * m_increment;
+    }
+}
+
+#endif // __FAST_MIXER__
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastOscillator added.
+// 17/10/26: ToFixedPoint() and ToHalfTurns() made public for FastMixer.
+//
+
+#ifndef __FAST_OSCILLATOR__
+#define __FAST_OSCILLATOR__
+
+#include "fast_sin.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// FastOscillator: A class to generate frequency and/or phase modulated sine waves block by block.
+// T, Degree: as in FastSin.
+//   The phase is kept in a 64-bit integer where 2^64 is one full turn, so integrating the
+// frequencies is exact and the wrap-around of the integer is the reduction to one turn. The
+// phase is kept between the calls, so consecutive blocks continue without discontinuities.
+//   Each block is processed in two passes: the (serial) phase integration writes the angles of
+// up to BLOCK_SIZE samples into a buffer, then the FastSinCos polynomial is evaluated for the
+// whole buffer in a loop that the compiler can vectorize.
+//   Frequencies are in cycles per sample (frequency in Hz / sample rate) and phase offsets
+// (phase modulation) are in radians. Output sample i is sin(2*Pi*phase(i) + phaseOffsets[i]),
+// where phase(0) is the current phase and phase(i+1) = phase(i) + frequencies[i].
+//
+// Usage example:
+// FastOscillator<float> oscillator;
+// oscillator(frequencies, out, 512);               // FM: per-sample frequency
+// oscillator(440.0f / 48000.0f, offsets, out, 512); // PM: constant carrier, per-sample phase offset
+//
+template<typename T = double, int Degree = 7>
+class FastOscillator
+{
+public:
+    // phase: initial phase in turns (1 = full circle)
+    explicit FastOscillator(T phase = static_cast<T>(0.0));
+
+    // FM: frequencies: @count frequencies in cycles per sample
+    // out: returns @count samples
+    void operator()(const T* frequencies, T* out, std::size_t count);
+
+    // PM: frequency: constant carrier frequency in cycles per sample
+    // phaseOffsets: @count phase offsets in radians
+    // out: returns @count samples
+    void operator()(T frequency, const T* phaseOffsets, T* out, std::size_t count);
+
+    // FM and PM together.
+    void operator()(const T* frequencies, const T* phaseOffsets, T* out, std::size_t count);
+
+    // returns: the current phase in turns, [0, 1)
+    T Phase() const;
+
+    // phase: new phase in turns
+    void SetPhase(T phase);
+
+    // turns: any finite value, only the fractional part matters
+    // returns: @turns as a fixed point phase (2^64 = one turn)
+    static std::uint64_t ToFixedPoint(T turns);
+
+    // phase: fixed point phase
+    // returns: the phase in half turns, [-1, 1)
+    static T ToHalfTurns(std::uint64_t phase);
+
+private:
+    // Calls frequencyAt(i) and offsetAt(i) (half turns) for every sample.
+    template<typename FrequencyAt, typename OffsetAt>
+    void Process(FrequencyAt frequencyAt, OffsetAt offsetAt, T* out, std::size_t count);
+
+    inline const static std::size_t BLOCK_SIZE{ 256 };
+    inline const static double FAST_SIN_PI{ 3.141592653589793 };
+    inline const static double TWO_POW_64{ 18446744073709551616.0 };
+    inline const static double TWO_POW_MINUS_63{ 1.0 / 9223372036854775808.0 };
+
+    std::uint64_t m_phase;
+};
+
+template<typename T, int Degree>
+FastOscillator<T, Degree>::FastOscillator(const T phase) :
+    m_phase{ ToFixedPoint(phase) }
+{
+}
+
+template<typename T, int Degree>
+void FastOscillator<T, Degree>::operator()(const T* const frequencies, T* const out, const std::size_t count)
+{
+    Process([frequencies](const std::size_t i) { return frequencies[i]; },
+        [](std::size_t) { return static_cast<T>(0.0); }, out, count);
+}
+
+template<typename T, int Degree>
+void FastOscillator<T, Degree>::operator()(const T frequency, const T* const phaseOffsets, T* const out,
+    const std::size_t count)
+{
+    Process([frequency](std::size_t) { return frequency; },
+        [phaseOffsets](const std::size_t i) { return phaseOffsets[i] * static_cast<T>(1.0 / FAST_SIN_PI); },
+        out, count);
+}
+
+template<typename T, int Degree>
+void FastOscillator<T, Degree>::operator()(const T* const frequencies, const T* const phaseOffsets, T* const out,
+    const std::size_t count)
+{
+    Process([frequencies](const std::size_t i) { return frequencies[i]; },
+        [phaseOffsets](const std::size_t i) { return phaseOffsets[i] * static_cast<T>(1.0 / FAST_SIN_PI); },
+        out, count);
+}
+
+template<typename T, int Degree>
+T FastOscillator<T, Degree>::Phase() const
+{
+    // A phase just below a full turn rounds to 1 in T: that is the same angle as 0.
+    const T phase = static_cast<T>(static_cast<double>(m_phase) / TWO_POW_64);
+    return phase < static_cast<T>(1.0) ? phase : static_cast<T>(0.0);
+}
+
+template<typename T, int Degree>
+void FastOscillator<T, Degree>::SetPhase(const T phase)
+{
+    m_phase = ToFixedPoint(phase);
+}
+
+template<typename T, int Degree>
+template<typename FrequencyAt, typename OffsetAt>
+void FastOscillator<T, Degree>::Process(FrequencyAt frequencyAt, OffsetAt offsetAt, T* const out,
+    const std::size_t count)
+{
+    const FastSinCos<T, Degree> sinCos;
+    T halfTurns[BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t blockCount = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        for (std::size_t i = 0; i < blockCount; ++i)
+        {
+            halfTurns[i] = ToHalfTurns(m_phase) + offsetAt(start + i);
+            m_phase += ToFixedPoint(frequencyAt(start + i));
+        }
+        T* const blockOut = out + start;
+        for (std::size_t i = 0; i < blockCount; ++i)
+            blockOut[i] = sinCos.SinPi(halfTurns[i]);
+    }
+}
+
+template<typename T, int Degree>
+std::uint64_t FastOscillator<T, Degree>::ToFixedPoint(const T turns)
+{
+    // Remove the whole turns first: the rest is in [0, 1] (1 if a tiny negative value rounds
+    // up). The upper half is moved down by a turn (exact), so the value is in [-0.5, 0.5) and
+    // multiplying with 2^64 (exact) always fits into a signed 64-bit integer, and negative
+    // values wrap correctly.
+    const double value = static_cast<double>(turns);
+    const double fraction = value - std::floor(value);
+    const double centered = fraction < 0.5 ? fraction : fraction - 1.0;
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(centered * TWO_POW_64));
+}
+
+template<typename T, int Degree>
+T FastOscillator<T, Degree>::ToHalfTurns(const std::uint64_t phase)
+{
+    // As a signed value the phase is in [-2^63, 2^63), i.e. [-1, 1) half turns.
+    return static_cast<T>(static_cast<double>(static_cast<std::int64_t>(phase)) * TWO_POW_MINUS_63);
+}
+
+#endif // __FAST_OSCILLATOR__
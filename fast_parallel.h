@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. FastParallelFor added.
+//
+
+#ifndef __FAST_PARALLEL__
+#define __FAST_PARALLEL__
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// FastParallelFor: Splits the range [0, count) into one contiguous part per thread and calls
+// func(begin, end) for each part. Used by the multi-threaded batch kernels.
+// count: number of items
+// threads: number of threads, 0 = std::thread::hardware_concurrency()
+// func: called as func(std::size_t begin, std::size_t end), must be safe to call concurrently
+// for different parts. The calling thread handles the first part itself and returns when all
+// parts are done. If func (or starting a thread) throws, the other parts are still waited for
+// and then the first exception (in the order of the parts) is rethrown. Link with -pthread.
+//
+// Usage example:
+// FastParallelFor(rows, 0, [&](std::size_t begin, std::size_t end) { ProcessRows(begin, end); });
+//
+template<typename Func>
+void FastParallelFor(const std::size_t count, unsigned threads, Func func)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads > count)
+        threads = static_cast<unsigned>(count);
+    if (threads <= 1)
+    {
+        if (count > 0)
+            func(std::size_t{ 0 }, count);
+        return;
+    }
+    const std::size_t partSize = count / threads;
+    const std::size_t remainder = count % threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    // One exception slot per part: a joinable std::thread must not be destroyed (std::terminate),
+    // so the exceptions are caught, all started threads joined and only then rethrown.
+    std::vector<std::exception_ptr> errors(threads);
+    try
+    {
+        // The first @remainder parts get one extra item.
+        std::size_t begin = partSize + (remainder > 0 ? 1 : 0);
+        const std::size_t firstEnd = begin;
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            const std::size_t end = begin + partSize + (t < remainder ? 1 : 0);
+            workers.emplace_back([func, &errors, t, begin, end]() mutable
+                {
+                    try
+                    {
+                        func(begin, end);
+                    }
+                    catch (...)
+                    {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            begin = end;
+        }
+        func(std::size_t{ 0 }, firstEnd);
+    }
+    catch (...)
+    {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread& worker : workers)
+        worker.join();
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif // __FAST_PARALLEL__
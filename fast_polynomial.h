@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastPolynomial added.
+//
+
+#ifndef __FAST_POLYNOMIAL__
+#define __FAST_POLYNOMIAL__
+
+#include <iterator>
+
+// The evaluation order of FastPolynomial:
+//   Horner: c0 + x * (c1 + x * (c2 + ...)), the fewest operations but one long dependency chain
+//   Estrin: (c0 + c1 * x) + x^2 * ((c2 + c3 * x) + x^2 * ...), the pairs are independent, so
+// the latency is about log2(degree) multiply-adds (better for long polynomials in scalar code)
+enum class FastPolynomialScheme
+{
+    Horner, Estrin
+};
+
+// FastPolynomial: Evaluates the polynomial c0 + c1 * x + ... + cN * x^N with the coefficients
+// known at compile time.
+// Coefficients: a type with the coefficients c0..cN (lowest first) in a static array, e.g.
+//   struct ExpCoefficients { inline constexpr static double VALUES[]{ 1.0, 1.0, 0.5 }; };
+// Scheme: the evaluation order (Horner or Estrin)
+//   The chains are generated with template recursion on the coefficient index, so they are
+// straight-line code like a chain written by hand (no loops which could stop the
+// vectorization of the caller's batch loop). FastSin::Polynomial() is evaluated with it too.
+// Evaluate() is constexpr and only uses +, * and conversion of the coefficients to the scalar
+// type S, so it works for float and double (also in constant expressions) and for SIMD types
+// which support arithmetic with a scalar operand (e.g. GCC vector extensions or
+// std::experimental::simd).
+//
+// Usage example:
+// struct Coefficients { inline constexpr static double VALUES[]{ 1.0, -0.5, 0.0416666 }; };
+// auto c = FastPolynomial<Coefficients>::Evaluate(x * x); // about cos(x)
+// // SIMD: v4d is a GCC vector of 4 doubles (typedef double v4d __attribute__((vector_size(32))))
+// v4d v = FastPolynomial<Coefficients, FastPolynomialScheme::Estrin>::Evaluate<v4d, double>(x2);
+//
+template<typename Coefficients, FastPolynomialScheme Scheme = FastPolynomialScheme::Horner>
+class FastPolynomial
+{
+public:
+    // The degree N of the polynomial
+    inline constexpr static int DEGREE{ static_cast<int>(std::size(Coefficients::VALUES)) - 1 };
+
+    // x: value (scalar or SIMD)
+    // S: the scalar type of @V (the type of the coefficients in the calculations)
+    // returns: the value of the polynomial at @x
+    template<typename V, typename S = V>
+    constexpr static V Evaluate(V x);
+
+private:
+    static_assert(DEGREE >= 1, "FastPolynomial: the degree must be at least 1");
+
+    // returns: c[First] + x * (c[First + 1] + ...), up to c[DEGREE]
+    template<int First, typename V, typename S>
+    constexpr static V Horner(V x);
+
+    // returns: the polynomial with the @Count coefficients from c[First], split at the highest
+    // power of two below @Count
+    template<int First, int Count, typename V, typename S>
+    constexpr static V Estrin(V x);
+
+    // returns: @x^N, N is a power of two
+    template<int N, typename V>
+    constexpr static V Power(V x);
+
+    // returns: the highest power of two below @count (@count >= 2)
+    constexpr static int Split(int count);
+};
+
+template<typename Coefficients, FastPolynomialScheme Scheme>
+template<typename V, typename S>
+constexpr V FastPolynomial<Coefficients, Scheme>::Evaluate(const V x)
+{
+    if constexpr (Scheme == FastPolynomialScheme::Horner)
+        return Horner<0, V, S>(x);
+    else
+        return Estrin<0, DEGREE + 1, V, S>(x);
+}
+
+template<typename Coefficients, FastPolynomialScheme Scheme>
+template<int First, typename V, typename S>
+constexpr V FastPolynomial<Coefficients, Scheme>::Horner(const V x)
+{
+    if constexpr (First == DEGREE - 1)
+        return x * static_cast<S>(Coefficients::VALUES[DEGREE]) + static_cast<S>(Coefficients::VALUES[First]);
+    else
+        return Horner<First + 1, V, S>(x) * x + static_cast<S>(Coefficients::VALUES[First]);
+}
+
+template<typename Coefficients, FastPolynomialScheme Scheme>
+template<int First, int Count, typename V, typename S>
+constexpr V FastPolynomial<Coefficients, Scheme>::Estrin(const V x)
+{
+    if constexpr (Count == 1)
+        return V{} + static_cast<S>(Coefficients::VALUES[First]);
+    else if constexpr (Count == 2)
+        return x * static_cast<S>(Coefficients::VALUES[First + 1]) + static_cast<S>(Coefficients::VALUES[First]);
+    else
+    {
+        // The low part is a full power of two, so its pairs line up with the high part's.
+        constexpr int LOW{ Split(Count) };
+        return Estrin<First, LOW, V, S>(x) + Power<LOW, V>(x) * Estrin<First + LOW, Count - LOW, V, S>(x);
+    }
+}
+
+template<typename Coefficients, FastPolynomialScheme Scheme>
+template<int N, typename V>
+constexpr V FastPolynomial<Coefficients, Scheme>::Power(const V x)
+{
+    if constexpr (N == 1)
+        return x;
+    else
+    {
+        const V half = Power<N / 2, V>(x);
+        return half * half;
+    }
+}
+
+template<typename Coefficients, FastPolynomialScheme Scheme>
+constexpr int FastPolynomial<Coefficients, Scheme>::Split(const int count)
+{
+    int low = 1;
+    while (2 * low < count)
+        low *= 2;
+    return low;
+}
+
+#endif // __FAST_POLYNOMIAL__
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastPositionalEncoding added.
+// 17/10/26: An odd dModel is rejected in the constructor.
+//
+
+#ifndef __FAST_POSITIONAL_ENCODING__
+#define __FAST_POSITIONAL_ENCODING__
+
+#include "fast_sin.h"
+#include "fast_bfloat16.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+enum class FastPositionalLayout
+{
+    Interleaved,  // row: sin(p*w0), cos(p*w0), sin(p*w1), cos(p*w1), ...
+    Concatenated  // row: sin(p*w0), sin(p*w1), ..., cos(p*w0), cos(p*w1), ...
+};
+
+// FastPositionalEncoding: A class to generate the sinusoidal positional encodings of transformers:
+//   PE[p][2i] = sin(p * w_i), PE[p][2i+1] = cos(p * w_i), w_i = base^(-2i/dModel)
+// into a [positions x dModel] row-major buffer of T or bfloat16 (std::uint16_t, see fast_bfloat16.h).
+// T, Degree: as in FastSin.
+//   The positions are an arithmetic progression, so row p+1 is row p rotated by the angles w_i:
+// a complex multiplication per frequency that vectorizes along the row. Every @resyncInterval
+// rows the values are calculated again directly with FastSinCos (in double, because p * w_i
+// can be thousands of radians), so the error of the recurrence does not grow. The working
+// values are kept in T, so bfloat16 output does not feed its rounding back into the recurrence.
+//   dModel must be even: an odd one would leave the last column of every row (T and bfloat16)
+// unwritten, so the constructor rejects it.
+//
+// Usage example:
+// FastPositionalEncoding<float> encoding(512);
+// std::vector<float> table(1024 * 512);
+// encoding(1024, table.data());
+//
+template<typename T = double, int Degree = 7>
+class FastPositionalEncoding
+{
+public:
+    // dModel: model dimension (row length), even and at least 2 (otherwise throws
+    // std::invalid_argument)
+    // base: the base of the frequencies (10000 in "Attention Is All You Need")
+    // layout: the order of the sin and cos columns
+    // resyncInterval: number of rows between the directly calculated ones
+    explicit FastPositionalEncoding(std::size_t dModel, double base = 10000.0,
+        FastPositionalLayout layout = FastPositionalLayout::Interleaved, std::size_t resyncInterval = 32);
+
+    // positions: number of rows
+    // out: returns @positions * dModel values
+    // firstPosition: the position of the first row
+    void operator()(std::size_t positions, T* out, std::size_t firstPosition = 0) const;
+
+    // bfloat16 version
+    void operator()(std::size_t positions, std::uint16_t* out, std::size_t firstPosition = 0) const;
+
+private:
+    // Calculates the rows and calls store(row, sinValues, cosValues) for each of them.
+    template<typename Store>
+    void Generate(std::size_t positions, std::size_t firstPosition, Store store) const;
+
+    // row: output row, sinValues/cosValues: dModel/2 values
+    template<typename Out, typename Convert>
+    void StoreRow(Out* row, const T* sinValues, const T* cosValues, Convert convert) const;
+
+    std::size_t m_dModel;
+    FastPositionalLayout m_layout;
+    std::size_t m_resyncInterval;
+    // w_i
+    std::vector<double> m_frequencies;
+    // sin(w_i) and cos(w_i): the rotation from one row to the next
+    std::vector<T> m_rotationSin;
+    std::vector<T> m_rotationCos;
+};
+
+template<typename T, int Degree>
+FastPositionalEncoding<T, Degree>::FastPositionalEncoding(const std::size_t dModel, const double base,
+    const FastPositionalLayout layout, const std::size_t resyncInterval) :
+    m_dModel{ dModel },
+    m_layout{ layout },
+    m_resyncInterval{ resyncInterval > 0 ? resyncInterval : 1 },
+    m_frequencies(dModel / 2),
+    m_rotationSin(dModel / 2),
+    m_rotationCos(dModel / 2)
+{
+    if (dModel == 0 || dModel % 2 != 0)
+        throw std::invalid_argument("FastPositionalEncoding: dModel must be even and at least 2");
+    // The recurrence multiplies the error of the rotation with the number of steps, so it is
+    // calculated with the most accurate polynomial (only once).
+    const FastSinCos<double, 15> sinCos;
+    for (std::size_t i = 0; i < m_frequencies.size(); ++i)
+    {
+        m_frequencies[i] = std::pow(base, -static_cast<double>(2 * i) / static_cast<double>(dModel));
+        double sinValue, cosValue;
+        sinCos(m_frequencies[i], sinValue, cosValue);
+        m_rotationSin[i] = static_cast<T>(sinValue);
+        m_rotationCos[i] = static_cast<T>(cosValue);
+    }
+}
+
+template<typename T, int Degree>
+void FastPositionalEncoding<T, Degree>::operator()(const std::size_t positions, T* const out,
+    const std::size_t firstPosition) const
+{
+    Generate(positions, firstPosition, [this, out](const std::size_t row, const T* sinValues, const T* cosValues)
+        {
+            StoreRow(out + row * m_dModel, sinValues, cosValues, [](const T value) { return value; });
+        });
+}
+
+template<typename T, int Degree>
+void FastPositionalEncoding<T, Degree>::operator()(const std::size_t positions, std::uint16_t* const out,
+    const std::size_t firstPosition) const
+{
+    Generate(positions, firstPosition, [this, out](const std::size_t row, const T* sinValues, const T* cosValues)
+        {
+            StoreRow(out + row * m_dModel, sinValues, cosValues,
+                [](const T value) { return FastFloatToBFloat16(static_cast<float>(value)); });
+        });
+}
+
+template<typename T, int Degree>
+template<typename Store>
+void FastPositionalEncoding<T, Degree>::Generate(const std::size_t positions, const std::size_t firstPosition,
+    Store store) const
+{
+    const FastSinCos<double, Degree> sinCos;
+    const std::size_t half = m_frequencies.size();
+    const double* const frequencies = m_frequencies.data();
+    const T* const rotationSin = m_rotationSin.data();
+    const T* const rotationCos = m_rotationCos.data();
+    std::vector<T> sinValues(half), cosValues(half);
+    T* const sinRow = sinValues.data();
+    T* const cosRow = cosValues.data();
+    for (std::size_t row = 0; row < positions; ++row)
+    {
+        if (row % m_resyncInterval == 0)
+        {
+            const double position = static_cast<double>(firstPosition + row);
+            for (std::size_t i = 0; i < half; ++i)
+            {
+                double sinValue, cosValue;
+                sinCos(position * frequencies[i], sinValue, cosValue);
+                sinRow[i] = static_cast<T>(sinValue);
+                cosRow[i] = static_cast<T>(cosValue);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < half; ++i)
+            {
+                const T sinValue = sinRow[i];
+                const T cosValue = cosRow[i];
+                sinRow[i] = sinValue * rotationCos[i] + cosValue * rotationSin[i];
+                cosRow[i] = cosValue * rotationCos[i] - sinValue * rotationSin[i];
+            }
+        }
+        store(row, sinRow, cosRow);
+    }
+}
+
+template<typename T, int Degree>
+template<typename Out, typename Convert>
+void FastPositionalEncoding<T, Degree>::StoreRow(Out* const row, const T* const sinValues, const T* const cosValues,
+    Convert convert) const
+{
+    const std::size_t half = m_frequencies.size();
+    if (m_layout == FastPositionalLayout::Interleaved)
+    {
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            row[2 * i] = convert(sinValues[i]);
+            row[2 * i + 1] = convert(cosValues[i]);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            row[i] = convert(sinValues[i]);
+            row[half + i] = convert(cosValues[i]);
+        }
+    }
+}
+
+#endif // __FAST_POSITIONAL_ENCODING__
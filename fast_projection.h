@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastProjection added.
+//
+
+#ifndef __FAST_PROJECTION__
+#define __FAST_PROJECTION__
+
+#include "fast_sin.h"
+#include "fast_oscillator.h"
+#include "fast_parallel.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// FastProjection: A class to project a signal onto a sinusoid (lock-in detection, single DFT bins):
+//   sinSum = sum of x[n] * sin(2*Pi*frequency*n + phase)
+//   cosSum = sum of x[n] * cos(2*Pi*frequency*n + phase)
+// T, Degree: as in FastSin.
+//   The sinusoid is generated on the fly with FastSinCos (the angles as in FastMixer: an exact
+// fixed point phase at the start of every block of BLOCK_SIZE samples), so nothing is stored.
+// The sums are accumulated in LANES independent lanes with Kahan compensated summation, so the
+// inner loop can be vectorized over the lanes and long windows do not lose accuracy.
+// NOTE: -ffast-math (-fassociative-math) removes the compensation.
+//   The multi-bin version runs the bins in parallel threads (see FastParallelFor).
+//
+// Usage example:
+// FastProjection<float> projection;
+// float sinSum, cosSum;
+// projection(samples, 48000, 1000.0f / 48000.0f, 0.0f, sinSum, cosSum);
+// float amplitude = 2.0f * std::sqrt(sinSum * sinSum + cosSum * cosSum) / 48000;
+//
+template<typename T = double, int Degree = 7>
+class FastProjection
+{
+public:
+    // x: @count samples
+    // frequency: in cycles per sample (frequency in Hz / sample rate)
+    // phase: in radians
+    // sinSum, cosSum: return the projections onto sin and cos
+    void operator()(const T* x, std::size_t count, T frequency, T phase, T& sinSum, T& cosSum) const;
+
+    // Multi-bin version: the same for @bins frequencies.
+    // phases: @bins phases in radians, or nullptr for zero phases
+    // sinSums, cosSums: return @bins projections
+    // threads: number of threads, 0 = std::thread::hardware_concurrency()
+    void operator()(const T* x, std::size_t count, const T* frequencies, const T* phases, std::size_t bins,
+        T* sinSums, T* cosSums, unsigned threads = 0) const;
+
+private:
+    // Kahan summation: adds @value to @sum, @compensation keeps the lost low-order bits.
+    static void AddCompensated(T& sum, T& compensation, T value);
+
+    inline const static std::size_t LANES{ 8 };
+    // must be a multiple of LANES
+    inline const static std::size_t BLOCK_SIZE{ 256 };
+    inline const static double FAST_SIN_PI{ 3.141592653589793 };
+};
+
+template<typename T, int Degree>
+void FastProjection<T, Degree>::operator()(const T* const x, const std::size_t count, const T frequency,
+    const T phase, T& sinSum, T& cosSum) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const std::uint64_t increment = FastOscillator<T, Degree>::ToFixedPoint(frequency);
+    const double incrementHalfTurns = FastOscillator<double, Degree>::ToHalfTurns(increment);
+    const double phaseHalfTurns = static_cast<double>(phase) / FAST_SIN_PI;
+
+    T sinSums[LANES]{}, sinCompensations[LANES]{}, cosSums[LANES]{}, cosCompensations[LANES]{};
+    std::uint64_t blockPhase = 0;
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t blockCount = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const std::size_t fullCount = blockCount - blockCount % LANES;
+        const double startHalfTurns = FastOscillator<double, Degree>::ToHalfTurns(blockPhase) + phaseHalfTurns;
+        const T* const blockX = x + start;
+        const auto accumulate = [&](const std::size_t i, const std::size_t lane)
+        {
+            // The index goes through int because 64-bit integer to double conversion does not vectorize.
+            double halfTurns = startHalfTurns + static_cast<double>(static_cast<int>(i)) * incrementHalfTurns;
+            halfTurns -= 2.0 * std::floor(0.5 * halfTurns + 0.5);
+            T sinValue, cosValue;
+            sinCos.SinCosPi(static_cast<T>(halfTurns), sinValue, cosValue);
+            const T value = blockX[i];
+            AddCompensated(sinSums[lane], sinCompensations[lane], value * sinValue);
+            AddCompensated(cosSums[lane], cosCompensations[lane], value * cosValue);
+        };
+        std::size_t i = 0;
+        for (; i < fullCount; i += LANES)
+        {
+            for (std::size_t lane = 0; lane < LANES; ++lane)
+                accumulate(i + lane, lane);
+        }
+        for (std::size_t lane = 0; i + lane < blockCount; ++lane)
+            accumulate(i + lane, lane);
+        blockPhase += static_cast<std::uint64_t>(blockCount) * increment;
+    }
+
+    // Combine the lanes. The compensation is the amount the sum is too big.
+    T sinTotal{}, sinCompensation{}, cosTotal{}, cosCompensation{};
+    for (std::size_t lane = 0; lane < LANES; ++lane)
+    {
+        AddCompensated(sinTotal, sinCompensation, sinSums[lane]);
+        AddCompensated(sinTotal, sinCompensation, -sinCompensations[lane]);
+        AddCompensated(cosTotal, cosCompensation, cosSums[lane]);
+        AddCompensated(cosTotal, cosCompensation, -cosCompensations[lane]);
+    }
+    sinSum = sinTotal - sinCompensation;
+    cosSum = cosTotal - cosCompensation;
+}
+
+template<typename T, int Degree>
+void FastProjection<T, Degree>::operator()(const T* const x, const std::size_t count, const T* const frequencies,
+    const T* const phases, const std::size_t bins, T* const sinSums, T* const cosSums, const unsigned threads) const
+{
+    FastParallelFor(bins, threads, [&](const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t bin = begin; bin < end; ++bin)
+            {
+                const T phase = phases != nullptr ? phases[bin] : static_cast<T>(0.0);
+                (*this)(x, count, frequencies[bin], phase, sinSums[bin], cosSums[bin]);
+            }
+        });
+}
+
+template<typename T, int Degree>
+void FastProjection<T, Degree>::AddCompensated(T& sum, T& compensation, const T value)
+{
+    const T corrected = value - compensation;
+    const T newSum = sum + corrected;
+    compensation = (newSum - sum) - corrected;
+    sum = newSum;
+}
+
+#endif // __FAST_PROJECTION__
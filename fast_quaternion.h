@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastQuaternion added.
+// 17/10/26: Slerp uses FastAcos.
+//
+
+#ifndef __FAST_QUATERNION__
+#define __FAST_QUATERNION__
+
+#include "fast_sin.h"
+#include "fast_asin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// FastQuaternion: A class for batch quaternion operations that need trigonometry:
+//   Slerp:         spherical linear interpolation q0 -> q1 (shortest path)
+//   FromAxisAngle: unit axis and angle -> quaternion
+//   Exp:           rotation vector (axis * angle) -> quaternion (the exponential map)
+// T, Degree: as in FastSin.
+//   The quaternions are SoA planes of @planeStride values (w, x, y, z), element e of quaternion n
+// is at q[e * planeStride + n] (the layout of FastEuler). The quaternions are processed in
+// blocks of BLOCK_SIZE, one short loop per step with the results in local buffers: the loops
+// have no branches and no possible aliasing, so the compiler can vectorize them (see FastSinCos
+// for the compiler options; GCC also needs -fno-math-errno to vectorize std::sqrt).
+//   Slerp calculates the angle between the quaternions with FastAcos (fast_asin.h), whose
+// accuracy matches the FastSin polynomial of the same Degree. Both angles are then in [0, Pi/2], so the sines
+// are the FastSin polynomials without argument reduction. The weights are written with
+// sin(x)/x, which goes smoothly to 1 for small angles:
+//   sin(t*theta) / sin(theta) = t * (sin(t*theta)/(t*theta)) / (sin(theta)/theta)
+// so nearly equal quaternions need no special case (x is kept at least epsilon, and there
+// sin(x)/x is set to exactly 1: the polynomial quotient would give its leading coefficient,
+// e.g. 0.99999906 for Degree 7). Exp uses the same sin(x)/x form for the angle / 2.
+//
+// Usage example:
+// FastQuaternion<float> quaternion;
+// quaternion.Slerp(from, to, weights, blended, bones);
+//
+template<typename T = double, int Degree = 7>
+class FastQuaternion
+{
+public:
+    // q0, q1: @count quaternions (w, x, y, z planes), unit length
+    // t: @count interpolation parameters in [0, 1]
+    // out: returns the interpolated quaternions (can be q0 or q1)
+    // planeStride: distance of the planes in values, 0 = @count
+    void Slerp(const T* q0, const T* q1, const T* t, T* out, std::size_t count, std::size_t planeStride = 0) const;
+
+    // axes: @count unit rotation axes (x, y, z planes)
+    // angles: @count rotation angles in radians
+    // out: returns the quaternions (w, x, y, z planes)
+    // planeStride: distance of the planes in values, 0 = @count
+    void FromAxisAngle(const T* axes, const T* angles, T* out, std::size_t count, std::size_t planeStride = 0) const;
+
+    // rotationVectors: @count rotation vectors (axis * angle, x, y, z planes)
+    // out: returns exp(rotationVector / 2) as quaternions (w, x, y, z planes)
+    // planeStride: distance of the planes in values, 0 = @count
+    void Exp(const T* rotationVectors, T* out, std::size_t count, std::size_t planeStride = 0) const;
+
+private:
+    // x: in [0, Pi/2]
+    // returns: sin(@x) / @x
+    static T Sinc(T x);
+
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+};
+
+template<typename T, int Degree>
+void FastQuaternion<T, Degree>::Slerp(const T* const q0, const T* const q1, const T* const t, T* const out,
+    const std::size_t count, std::size_t planeStride) const
+{
+    const FastAcos<T, FastAsinDegree(Degree)> fastAcos;
+    if (planeStride == 0)
+        planeStride = count;
+    T sign[BLOCK_SIZE], theta[BLOCK_SIZE], invSinc[BLOCK_SIZE];
+    T sincValues[2 * BLOCK_SIZE];
+    T block[4][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const w0 = q0 + start;
+        const T* const x0 = q0 + planeStride + start;
+        const T* const y0 = q0 + 2 * planeStride + start;
+        const T* const z0 = q0 + 3 * planeStride + start;
+        const T* const w1 = q1 + start;
+        const T* const x1 = q1 + planeStride + start;
+        const T* const y1 = q1 + 2 * planeStride + start;
+        const T* const z1 = q1 + 3 * planeStride + start;
+        const T* const t1 = t + start;
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const T dot = w0[b] * w1[b] + x0[b] * x1[b] + y0[b] * y1[b] + z0[b] * z1[b];
+            // q and -q are the same rotation: take the shorter way.
+            sign[b] = dot < static_cast<T>(0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+            const T cosTheta = sign[b] * dot;
+            theta[b] = cosTheta < static_cast<T>(1.0) ? cosTheta : static_cast<T>(1.0);
+        }
+        for (std::size_t b = 0; b < size; ++b)
+            theta[b] = fastAcos(theta[b]);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            invSinc[b] = static_cast<T>(1.0) / Sinc(theta[b]);
+            sincValues[b] = Sinc((static_cast<T>(1.0) - t1[b]) * theta[b]);
+            sincValues[BLOCK_SIZE + b] = Sinc(t1[b] * theta[b]);
+        }
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const T weight0 = (static_cast<T>(1.0) - t1[b]) * sincValues[b] * invSinc[b];
+            const T weight1 = sign[b] * t1[b] * sincValues[BLOCK_SIZE + b] * invSinc[b];
+            block[0][b] = weight0 * w0[b] + weight1 * w1[b];
+            block[1][b] = weight0 * x0[b] + weight1 * x1[b];
+            block[2][b] = weight0 * y0[b] + weight1 * y1[b];
+            block[3][b] = weight0 * z0[b] + weight1 * z1[b];
+        }
+        for (int element = 0; element < 4; ++element)
+            std::copy(block[element], block[element] + size, out + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastQuaternion<T, Degree>::FromAxisAngle(const T* const axes, const T* const angles, T* const out,
+    const std::size_t count, std::size_t planeStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    if (planeStride == 0)
+        planeStride = count;
+    T halfAngles[BLOCK_SIZE], sinValues[BLOCK_SIZE];
+    T block[4][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const axisX = axes + start;
+        const T* const axisY = axes + planeStride + start;
+        const T* const axisZ = axes + 2 * planeStride + start;
+        for (std::size_t b = 0; b < size; ++b)
+            halfAngles[b] = static_cast<T>(0.5) * angles[start + b];
+        sinCos(halfAngles, sinValues, block[0], size);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            block[1][b] = sinValues[b] * axisX[b];
+            block[2][b] = sinValues[b] * axisY[b];
+            block[3][b] = sinValues[b] * axisZ[b];
+        }
+        for (int element = 0; element < 4; ++element)
+            std::copy(block[element], block[element] + size, out + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+void FastQuaternion<T, Degree>::Exp(const T* const rotationVectors, T* const out, const std::size_t count,
+    std::size_t planeStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    if (planeStride == 0)
+        planeStride = count;
+    T halfAngles[BLOCK_SIZE], sinValues[BLOCK_SIZE];
+    T block[4][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        const T* const vectorX = rotationVectors + start;
+        const T* const vectorY = rotationVectors + planeStride + start;
+        const T* const vectorZ = rotationVectors + 2 * planeStride + start;
+        // The half angles, kept at least epsilon so that sin(h)/h has no division by zero.
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const T vx = vectorX[b], vy = vectorY[b], vz = vectorZ[b];
+            const T halfAngle = static_cast<T>(0.5) * std::sqrt(vx * vx + vy * vy + vz * vz);
+            halfAngles[b] = halfAngle > std::numeric_limits<T>::epsilon() ? halfAngle : std::numeric_limits<T>::epsilon();
+        }
+        sinCos(halfAngles, sinValues, block[0], size);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            // sin(h) / (2 * h): the rotation vector is twice the half angle times the axis.
+            const T scale = halfAngles[b] > std::numeric_limits<T>::epsilon() ?
+                static_cast<T>(0.5) * sinValues[b] / halfAngles[b] : static_cast<T>(0.5);
+            block[1][b] = scale * vectorX[b];
+            block[2][b] = scale * vectorY[b];
+            block[3][b] = scale * vectorZ[b];
+        }
+        for (int element = 0; element < 4; ++element)
+            std::copy(block[element], block[element] + size, out + element * planeStride + start);
+    }
+}
+
+template<typename T, int Degree>
+inline T FastQuaternion<T, Degree>::Sinc(const T x)
+{
+    const T clamped = x > std::numeric_limits<T>::epsilon() ? x : std::numeric_limits<T>::epsilon();
+    const T value = FastSin<T, Degree>::Polynomial(clamped) / clamped;
+    return x > std::numeric_limits<T>::epsilon() ? value : static_cast<T>(1.0);
+}
+
+#endif // __FAST_QUATERNION__
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastRope added.
+//
+
+#ifndef __FAST_ROPE__
+#define __FAST_ROPE__
+
+#include "fast_sin.h"
+#include "fast_bfloat16.h"
+#include "fast_parallel.h"
+#include "fast_positional_encoding.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// FastRope: A class to apply rotary position embeddings (RoPE) to query/key tensors in place.
+// Pair i of every head of a token at position p is rotated by the angle p * w_i,
+// w_i = base^(-2i/headDim):
+//   (a, b) -> (a*cos - b*sin, a*sin + b*cos)
+// T, Degree: as in FastSin. T is the type of the calculations; the tensor can be T or
+// bfloat16 (std::uint16_t, see fast_bfloat16.h).
+//   The pairs are (x[2i], x[2i+1]) with FastPositionalLayout::Interleaved (GPT-J style) and
+// (x[i], x[i + headDim/2]) with FastPositionalLayout::Concatenated (rotate-half, GPT-NeoX style).
+//   cos and sin are calculated once per token and used for all heads. The angles p * w_i are
+// calculated in double, because p can be large, and then evaluated with FastSinCos<double>.
+// For positions below @cachedPositions the values are read from a table built in the
+// constructor instead. The tokens are processed in parallel threads (see FastParallelFor).
+//   The tensor layout is [tokens x heads x headDim], row-major.
+//
+// Usage example:
+// FastRope<float> rope(128, 10000.0, FastPositionalLayout::Concatenated, 4096);
+// rope(queries, positions, tokens, 32); // 32 heads
+//
+template<typename T = double, int Degree = 7>
+class FastRope
+{
+public:
+    // headDim: head dimension, even
+    // base: the base of the frequencies
+    // layout: the pairing of the values, see above
+    // cachedPositions: size of the cos/sin table (0 = no table)
+    explicit FastRope(std::size_t headDim, double base = 10000.0,
+        FastPositionalLayout layout = FastPositionalLayout::Interleaved, std::size_t cachedPositions = 0);
+
+    // x: [tokens x heads x headDim] values, rotated in place
+    // positions: @tokens positions, or nullptr for positions 0..tokens-1
+    // threads: number of threads, 0 = std::thread::hardware_concurrency()
+    void operator()(T* x, const std::size_t* positions, std::size_t tokens, std::size_t heads,
+        unsigned threads = 0) const;
+
+    // bfloat16 version
+    void operator()(std::uint16_t* x, const std::size_t* positions, std::size_t tokens, std::size_t heads,
+        unsigned threads = 0) const;
+
+private:
+    // Calls the rotation for all tokens, load/store convert between the tensor and T.
+    template<typename Value, typename Load, typename Store>
+    void Apply(Value* x, const std::size_t* positions, std::size_t tokens, std::size_t heads, unsigned threads,
+        Load load, Store store) const;
+
+    // position: token position
+    // cosValues, sinValues: return headDim/2 values of cos and sin of position * w_i
+    void Angles(std::size_t position, T* cosValues, T* sinValues) const;
+
+    std::size_t m_headDim;
+    FastPositionalLayout m_layout;
+    std::vector<double> m_frequencies;
+    std::size_t m_cachedPositions;
+    std::vector<T> m_cacheCos;
+    std::vector<T> m_cacheSin;
+};
+
+template<typename T, int Degree>
+FastRope<T, Degree>::FastRope(const std::size_t headDim, const double base, const FastPositionalLayout layout,
+    const std::size_t cachedPositions) :
+    m_headDim{ headDim },
+    m_layout{ layout },
+    m_frequencies(headDim / 2),
+    m_cachedPositions{ cachedPositions },
+    m_cacheCos(cachedPositions * (headDim / 2)),
+    m_cacheSin(cachedPositions * (headDim / 2))
+{
+    const std::size_t half = m_frequencies.size();
+    for (std::size_t i = 0; i < half; ++i)
+        m_frequencies[i] = std::pow(base, -static_cast<double>(2 * i) / static_cast<double>(headDim));
+    for (std::size_t position = 0; position < cachedPositions; ++position)
+        Angles(position, m_cacheCos.data() + position * half, m_cacheSin.data() + position * half);
+}
+
+template<typename T, int Degree>
+void FastRope<T, Degree>::operator()(T* const x, const std::size_t* const positions, const std::size_t tokens,
+    const std::size_t heads, const unsigned threads) const
+{
+    Apply(x, positions, tokens, heads, threads,
+        [](const T value) { return value; },
+        [](const T value) { return value; });
+}
+
+template<typename T, int Degree>
+void FastRope<T, Degree>::operator()(std::uint16_t* const x, const std::size_t* const positions,
+    const std::size_t tokens, const std::size_t heads, const unsigned threads) const
+{
+    Apply(x, positions, tokens, heads, threads,
+        [](const std::uint16_t value) { return static_cast<T>(FastBFloat16ToFloat(value)); },
+        [](const T value) { return FastFloatToBFloat16(static_cast<float>(value)); });
+}
+
+template<typename T, int Degree>
+template<typename Value, typename Load, typename Store>
+void FastRope<T, Degree>::Apply(Value* const x, const std::size_t* const positions, const std::size_t tokens,
+    const std::size_t heads, const unsigned threads, Load load, Store store) const
+{
+    FastParallelFor(tokens, threads, [&](const std::size_t begin, const std::size_t end)
+        {
+            const std::size_t headDim = m_headDim;
+            const std::size_t half = m_frequencies.size();
+            const bool interleaved = m_layout == FastPositionalLayout::Interleaved;
+            std::vector<T> cosBuffer(half), sinBuffer(half);
+            for (std::size_t token = begin; token < end; ++token)
+            {
+                const std::size_t position = positions != nullptr ? positions[token] : token;
+                const T* cosValues = cosBuffer.data();
+                const T* sinValues = sinBuffer.data();
+                if (position < m_cachedPositions)
+                {
+                    cosValues = m_cacheCos.data() + position * half;
+                    sinValues = m_cacheSin.data() + position * half;
+                }
+                else
+                    Angles(position, cosBuffer.data(), sinBuffer.data());
+
+                for (std::size_t head = 0; head < heads; ++head)
+                {
+                    Value* const values = x + (token * heads + head) * headDim;
+                    // Separate loops, so that both have constant strides and vectorize.
+                    if (interleaved)
+                    {
+                        for (std::size_t i = 0; i < half; ++i)
+                        {
+                            const T a = load(values[2 * i]);
+                            const T b = load(values[2 * i + 1]);
+                            values[2 * i] = store(a * cosValues[i] - b * sinValues[i]);
+                            values[2 * i + 1] = store(a * sinValues[i] + b * cosValues[i]);
+                        }
+                    }
+                    else
+                    {
+                        Value* const secondHalf = values + half;
+                        for (std::size_t i = 0; i < half; ++i)
+                        {
+                            const T a = load(values[i]);
+                            const T b = load(secondHalf[i]);
+                            values[i] = store(a * cosValues[i] - b * sinValues[i]);
+                            secondHalf[i] = store(a * sinValues[i] + b * cosValues[i]);
+                        }
+                    }
+                }
+            }
+        });
+}
+
+template<typename T, int Degree>
+void FastRope<T, Degree>::Angles(const std::size_t position, T* const cosValues, T* const sinValues) const
+{
+    const FastSinCos<double, Degree> sinCos;
+    const double* const frequencies = m_frequencies.data();
+    const double p = static_cast<double>(position);
+    for (std::size_t i = 0; i < m_frequencies.size(); ++i)
+    {
+        double sinValue, cosValue;
+        sinCos(p * frequencies[i], sinValue, cosValue);
+        cosValues[i] = static_cast<T>(cosValue);
+        sinValues[i] = static_cast<T>(sinValue);
+    }
+}
+
+#endif // __FAST_ROPE__
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastRotation2D added.
+//
+
+#ifndef __FAST_ROTATION__
+#define __FAST_ROTATION__
+
+#include "fast_sin.h"
+
+#include <cstddef>
+
+// FastRotation2D: A class to convert polar coordinates to Cartesian and to rotate 2D points,
+// each element with its own angle:
+//   PolarToCartesian: (r, theta) -> (r*cos(theta), r*sin(theta))
+//   RotatePoints:     (x, y), heading -> (x*cos - y*sin, x*sin + y*cos)
+// T, Degree: as in FastSin.
+//   Sine and Cosine of every angle come from one shared argument reduction (FastSinCos) and are
+// used directly in the same loop, so there are no intermediate sin/cos buffers. The loops have
+// no branches and can be vectorized (see FastSinCos for the compiler options).
+//   Both SoA (separate x and y arrays) and AoS (interleaved x, y pairs) layouts are supported.
+// The outputs can be the same arrays as the inputs (in place).
+//
+// Usage example:
+// FastRotation2D<float> rotation;
+// rotation.PolarToCartesian(r, theta, x, y, 1024);
+// rotation.RotatePoints(x, y, headings, x, y, 1024); // in place
+//
+template<typename T = double, int Degree = 7>
+class FastRotation2D
+{
+public:
+    // r, theta: @count radii and angles in radians
+    // x, y: return the Cartesian coordinates
+    void PolarToCartesian(const T* r, const T* theta, T* x, T* y, std::size_t count) const;
+
+    // AoS version
+    // polar: @count (r, theta) pairs
+    // xy: returns @count (x, y) pairs
+    void PolarToCartesian(const T* polar, T* xy, std::size_t count) const;
+
+    // x, y: @count points
+    // headings: @count rotation angles in radians (counterclockwise)
+    // outX, outY: return the rotated points
+    void RotatePoints(const T* x, const T* y, const T* headings, T* outX, T* outY, std::size_t count) const;
+
+    // AoS version
+    // points: @count (x, y) pairs
+    // headings: @count rotation angles in radians
+    // out: returns @count rotated (x, y) pairs
+    void RotatePoints(const T* points, const T* headings, T* out, std::size_t count) const;
+};
+
+template<typename T, int Degree>
+void FastRotation2D<T, Degree>::PolarToCartesian(const T* const r, const T* const theta, T* const x, T* const y,
+    const std::size_t count) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T radius = r[i];
+        T sinValue, cosValue;
+        sinCos(theta[i], sinValue, cosValue);
+        x[i] = radius * cosValue;
+        y[i] = radius * sinValue;
+    }
+}
+
+template<typename T, int Degree>
+void FastRotation2D<T, Degree>::PolarToCartesian(const T* const polar, T* const xy, const std::size_t count) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T radius = polar[2 * i];
+        T sinValue, cosValue;
+        sinCos(polar[2 * i + 1], sinValue, cosValue);
+        xy[2 * i] = radius * cosValue;
+        xy[2 * i + 1] = radius * sinValue;
+    }
+}
+
+template<typename T, int Degree>
+void FastRotation2D<T, Degree>::RotatePoints(const T* const x, const T* const y, const T* const headings,
+    T* const outX, T* const outY, const std::size_t count) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T pointX = x[i];
+        const T pointY = y[i];
+        T sinValue, cosValue;
+        sinCos(headings[i], sinValue, cosValue);
+        outX[i] = pointX * cosValue - pointY * sinValue;
+        outY[i] = pointX * sinValue + pointY * cosValue;
+    }
+}
+
+template<typename T, int Degree>
+void FastRotation2D<T, Degree>::RotatePoints(const T* const points, const T* const headings, T* const out,
+    const std::size_t count) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T pointX = points[2 * i];
+        const T pointY = points[2 * i + 1];
+        T sinValue, cosValue;
+        sinCos(headings[i], sinValue, cosValue);
+        out[2 * i] = pointX * cosValue - pointY * sinValue;
+        out[2 * i + 1] = pointX * sinValue + pointY * cosValue;
+    }
+}
+
+#endif // __FAST_ROTATION__
@@ -35,17 +35,35 @@
 // Version info
 // 07/03/21: Juha Kettunen
 // First version. class FastSin added.
+// 17/10/26: Degrees 11, 13 and 15 added. FastSin::Polynomial() and class FastSinCos added.
+// 17/10/26: FastSinCos::SinPi() and FastSinCos::CosPi() added.
+// 17/10/26: FastSinCos::Sin() and FastSinCos::Cos() added.
+// 17/10/26: The polynomials and the scalar FastSinCos functions made inline, so that they are
+// inlined into the batch loops (and the loops vectorized) also when called from many places.
+// 17/10/26: FastSinCos::SinCosDegrees() added.
+// 17/10/26: struct FastDual and the FastSinCos dual number overloads added.
+// 17/10/26: FastSin::Polynomial() evaluated with FastPolynomial (fast_polynomial.h).
+// 17/10/26: FastSinCos::ReduceQuarterTurns() added.
 //
 
 #ifndef __FAST_SIN__
 #define __FAST_SIN__
 
+#include "fast_polynomial.h"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
 // FastSin: A class to calculate mathematical sin for a given angle in radians.
 // T: The type of the calculations/return value (double/float)
 // Degree: the degree of the polynomial approximation used when approximation Sin.
-// Can be 7 or 9 (9 is more accurate).
-// Maximum error for Degree 7: 9.39101e-07
-// Maximum error for Degree 9: 5.31399e-09
+// Can be 7, 9, 11, 13 or 15 (higher is more accurate).
+// Maximum error for Degree 7: 9.39102e-07
+// Maximum error for Degree 9: 5.31400e-09
+// Maximum error for Degree 11: 2.11510e-11
+// Maximum error for Degree 13: 6.26804e-14
+// Maximum error for Degree 15: 4.19641e-16 (use with double, close to the accuracy of std::sin())
 // According to my testings FastSin seems to be 80%-340% faster than std::sin(). 
 //   NOTE: FastSin is only fast if you call it so that your consequent angles
 // are close (about 2*Pi) to each others. So for example calling with angles: 1.521, 1.540, 1.600, 1.425.
@@ -77,7 +95,64 @@ public:
     // argument Degree level of polynomial approximation.
     T operator()(T angle);
 
+    // x: angle in radians in the range [-Pi/2, Pi/2]
+    // returns: the polynomial approximation of Sine for @x. No argument reduction is
+    // done, so this is the building block for the classes which do their own reduction.
+    static T Polynomial(T x);
+
 private:
+    static_assert(Degree == 7 || Degree == 9 || Degree == 11 || Degree == 13 || Degree == 15,
+        "FastSin: Degree must be 7, 9, 11, 13 or 15");
+
+    // The coefficients of P(x^2), sin(x) = x * P(x^2), for each Degree.
+    //
+    // Below, tests done using a for loop:
+    // (*) for (long long i{ -3610000000 }; i < 3610000000; ++i)
+    //      angle =  i / 10000000.0;
+    //
+    // degree 7: x1*(0.999999060898976336474926982596043563 + x2*(-0.166655540927576933646197607200949732 + x2*(0.00831189980138987918776159520367912155 - 0.000184881402886071911033139680005197992*x2)))
+    // degree 9: x1*(0.999999994686007336752316120259640318 + x2*(-0.166666566840071513590695269999128453 + x2*(0.00833302513896936729848481553136180314 + x2*(-0.000198074187274269708745741141088641071 + 2.60190306765146018582500885337773154e-6*x2))))
+    // degree 11: x1*(0.999999999978848986004024252020136376 + x2*(-0.166666666088260696413164073700518966 + x2*(0.0083333307205577364537649859680559134 + x2*(-0.000198408328232619552900716711096802991 + x2*(2.75239710746326498359158614319960747e-6 - 2.38683465210310275648901646899447956e-8*x2)))))
+    // degree 13: x1*(0.99999999999993755993181866699050341 + x2*(-0.166666666664323314581815741469216905 + x2*(0.00833333331876551401513170690076633426 + x2*(-0.000198412664116221500983643363235801621 + x2*(2.75569319265949080405272256029630435e-6 + x2*(-2.50295188656032073461541806142955172e-8 + 1.54011703714146442092105042668219399e-10*x2))))))
+    // degree 15: x1*(0.999999999999999857838569472803436094 + x2*(-0.166666666666659653164780128856655815 + x2*(0.0083333333332759213967605753588041778 + x2*(-0.000198412698232225093689107179234916997 + x2*(2.75573164212929639596438001437716264e-6 + x2*(-2.50518708834909025185443888256390484e-8 + x2*(1.60478446330181144268346920373498950e-10 - 7.37066278281678177542459044637025041e-13*x2)))))))
+    struct Coefficients7
+    {
+        // degree 7 - Maximum error (*): 9.39102e-07
+        inline constexpr static double VALUES[]{ 0.999999060898976, -0.166655540927576, 0.00831189980138987,
+            -0.000184881402886071 };
+    };
+    struct Coefficients9
+    {
+        // degree 9 - Maximum error (*): 5.31400e-09
+        inline constexpr static double VALUES[]{ 0.999999994686007, -0.166666566840071, 0.00833302513896936,
+            -0.000198074187274269, 2.601903067651460e-6 };
+    };
+    struct Coefficients11
+    {
+        // degree 11 - Maximum error: 2.11510e-11
+        inline constexpr static double VALUES[]{ 0.999999999978848986, -0.166666666088260696,
+            0.00833333072055773645, -0.000198408328232619553, 2.75239710746326498e-6, -2.38683465210310276e-8 };
+    };
+    struct Coefficients13
+    {
+        // degree 13 - Maximum error: 6.26804e-14
+        inline constexpr static double VALUES[]{ 0.999999999999937560, -0.166666666664323315,
+            0.00833333331876551402, -0.000198412664116221501, 2.75569319265949080e-6, -2.50295188656032073e-8,
+            1.54011703714146442e-10 };
+    };
+    struct Coefficients15
+    {
+        // degree 15 - Maximum error: 4.19641e-16
+        inline constexpr static double VALUES[]{ 0.999999999999999858, -0.166666666666659653,
+            0.00833333333327592140, -0.000198412698232225094, 2.75573164212929640e-6, -2.50518708834909025e-8,
+            1.60478446330181144e-10, -7.37066278281678178e-13 };
+    };
+    // Use the polynomial degree according to the template argument @Degree.
+    using Coefficients = typename std::conditional<Degree == 7, Coefficients7,
+        typename std::conditional<Degree == 9, Coefficients9,
+        typename std::conditional<Degree == 11, Coefficients11,
+        typename std::conditional<Degree == 13, Coefficients13, Coefficients15>::type>::type>::type>::type;
+
     // constants used for speedy calculation of the (next) approximation
     inline const static double FAST_SIN_PI{ 3.141592653589793 };
     inline const static double PI_DIV_2{ FAST_SIN_PI / 2.0 };
@@ -166,27 +241,303 @@ T FastSin<T, Degree>::operator()(const T angle)
     m_previousAngle = angle;
     m_hasValidPreviousAngle = true;
 
-    // Use the polynomial degree according to the template argument @Degree.
-    //
-    // Below, tests done using a for loop:
-    // (*) for (long long i{ -3610000000 }; i < 3610000000; ++i)
-    //      angle =  i / 10000000.0;
-    //
-    // degree 7: x1*(0.999999060898976336474926982596043563 + x2*(-0.166655540927576933646197607200949732 + x2*(0.00831189980138987918776159520367912155 - 0.000184881402886071911033139680005197992*x2)))
-    // degree 9: x1*(0.999999994686007336752316120259640318 + x2*(-0.166666566840071513590695269999128453 + x2*(0.00833302513896936729848481553136180314 + x2*(-0.000198074187274269708745741141088641071 + 2.60190306765146018582500885337773154e-6*x2))))
-    if constexpr (Degree == 7)
+    // The polynomial is evaluated in double (with the coefficients rounded to T), as it always
+    // was here, so that FastSin<float> keeps its accuracy. Polynomial() calculates in T.
+    return static_cast<T>(sign * x1 * FastPolynomial<Coefficients>::template Evaluate<double, T>(x2));
+}
+
+template<typename T, int Degree>
+inline T FastSin<T, Degree>::Polynomial(const T x)
+{
+    return x * FastPolynomial<Coefficients>::Evaluate(x * x);
+}
+
+// FastDual: A dual number for forward mode automatic differentiation: a value and its
+// derivatives with respect to N variables (N = 1 is the classic dual number x + x' * e).
+// FastSinCos has overloads which take the angle as a FastDual.
+template<typename T = double, int N = 1>
+struct FastDual
+{
+    T value;
+    T derivatives[N];
+};
+
+// FastSinCos: A class to calculate both mathematical sin and cos for a given angle in radians.
+// Both values are calculated from one shared argument reduction using the FastSin polynomials,
+// so the cosine costs only one more polynomial evaluation.
+// T, Degree: as in FastSin.
+//   Unlike FastSin this class has no state, so the angles can be passed in any order. The
+// argument reduction has no branches, so the compiler can vectorize the batch versions
+// (the ones taking pointers) when optimizations are on (e.g. -O3 -march=native; GCC also
+// needs -fno-trapping-math to vectorize std::floor).
+//   SinCosPi() calculates sin(Pi * x) and cos(Pi * x). Its reduction is exact (no rounding
+// error from multiplying with Pi), so it should be used when the angle is a fraction of the
+// full circle, like 2*Pi*k/N. SinCosDegrees() does the same in degrees: the whole half turns
+// (180 degrees) are removed exactly before converting to radians, so e.g. sin(180) and cos(90)
+// are exactly zero.
+//   The FastDual overloads also return the derivatives: d sin(x) = cos(x) * dx and
+// d cos(x) = -sin(x) * dx. Both need sin(x) and cos(x) anyway, so one reduction and the two
+// polynomials give the values and all the derivatives (with N derivatives, 2N multiplications
+// more), and the error of the derivatives is the error of the values.
+//
+// Usage example:
+// FastSinCos<double, 9> fastSinCos;
+// double sinValue, cosValue;
+// fastSinCos(2.2351, sinValue, cosValue);
+// fastSinCos.SinCosPi(0.25, sinValue, cosValue); // sin(Pi/4) and cos(Pi/4)
+// FastDual<double, 3> angle{ 0.5, { 1.0, 0.0, 2.0 } }; // value and gradient
+// auto sinAngle = fastSinCos.Sin(angle); // sin(0.5), cos(0.5) * gradient
+//
+template<typename T = double, int Degree = 7>
+class FastSinCos
+{
+public:
+    // angle: in radians
+    // sinValue, cosValue: returns Sine and Cosine for the angle @angle
+    void operator()(T angle, T& sinValue, T& cosValue) const;
+
+    // Batch version: calculates Sine and Cosine for @count angles.
+    void operator()(const T* angles, T* sinValues, T* cosValues, std::size_t count) const;
+
+    // angle: in radians
+    // returns: Sine or Cosine alone, with the same reduction as operator()
+    T Sin(T angle) const;
+    T Cos(T angle) const;
+
+    // x: angle in half turns (the angle in radians divided by Pi)
+    // sinValue, cosValue: returns sin(Pi * x) and cos(Pi * x)
+    void SinCosPi(T x, T& sinValue, T& cosValue) const;
+
+    // Batch version: calculates sin(Pi * x) and cos(Pi * x) for @count values.
+    void SinCosPi(const T* x, T* sinValues, T* cosValues, std::size_t count) const;
+
+    // x: angle in half turns
+    // returns: sin(Pi * x) or cos(Pi * x) alone, with the same reduction as SinCosPi()
+    T SinPi(T x) const;
+    T CosPi(T x) const;
+
+    // degrees: angle in degrees
+    // sinValue, cosValue: returns Sine and Cosine for the angle @degrees
+    void SinCosDegrees(T degrees, T& sinValue, T& cosValue) const;
+
+    // Batch version: calculates Sine and Cosine for @count angles in degrees.
+    void SinCosDegrees(const T* degrees, T* sinValues, T* cosValues, std::size_t count) const;
+
+    // angle: in radians, with its derivatives
+    // sinValue, cosValue: returns Sine and Cosine for the angle @angle, with the derivatives
+    // (may be the same object as @angle)
+    template<int N>
+    void operator()(const FastDual<T, N>& angle, FastDual<T, N>& sinValue, FastDual<T, N>& cosValue) const;
+
+    // Batch version: calculates Sine and Cosine with the derivatives for @count angles.
+    template<int N>
+    void operator()(const FastDual<T, N>* angles, FastDual<T, N>* sinValues, FastDual<T, N>* cosValues,
+        std::size_t count) const;
+
+    // angle: in radians, with its derivatives
+    // returns: Sine or Cosine with the derivatives, with the same reduction as operator()
+    template<int N>
+    FastDual<T, N> Sin(const FastDual<T, N>& angle) const;
+    template<int N>
+    FastDual<T, N> Cos(const FastDual<T, N>& angle) const;
+
+    // angle: in radians
+    // quarterTurns: returns the nearest whole number of quarter turns (Pi/2) in @angle
+    // returns: @angle - quarterTurns * Pi/2, in [-Pi/4, Pi/4], with the Cody-Waite reduction of
+    // operator() (for the functions with a quarter turn period or symmetry, e.g. FastTan)
+    static T ReduceQuarterTurns(T angle, T& quarterTurns);
+
+private:
+    // halfTurns: a whole number of half turns (Pi) removed from the angle
+    // returns: (-1)^halfTurns, calculated without branches
+    static T HalfTurnSign(T halfTurns);
+
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+    inline const static double FAST_SIN_PI{ 3.141592653589793 };
+    inline const static double INV_PI{ 1.0 / FAST_SIN_PI };
+    inline const static double PI_DIV_2{ FAST_SIN_PI / 2.0 };
+    inline const static double RADIANS_PER_DEGREE{ FAST_SIN_PI / 180.0 };
+    // Pi split into three parts (Cody-Waite) so that angle - k*Pi does not lose accuracy for
+    // large angles: the first parts have so few significant bits that k*PART is exact.
+    inline const static bool IS_FLOAT{ sizeof(T) <= sizeof(float) };
+    inline const static double PI_PART1{ IS_FLOAT ? 3.140625 : 3.1415927410125732 };
+    inline const static double PI_PART2{ IS_FLOAT ? 9.67502593994140625e-04 : -8.7422776573475858e-08 };
+    inline const static double PI_PART3{ IS_FLOAT ? 1.509957990978376432e-07 : -3.4302489988857658e-15 };
+};
+
+template<typename T, int Degree>
+inline void FastSinCos<T, Degree>::operator()(const T angle, T& sinValue, T& cosValue) const
+{
+    // Remove the nearest whole number of half turns: the remaining angle is in [-Pi/2, Pi/2]
+    // where the FastSin polynomial is valid, and removing a half turn only flips the signs.
+    // Cosine is then sin(Pi/2 - |r|), so both come from the same reduction.
+    const T halfTurns = std::floor(angle * static_cast<T>(INV_PI) + static_cast<T>(0.5));
+    const T r = ((angle - halfTurns * static_cast<T>(PI_PART1)) - halfTurns * static_cast<T>(PI_PART2)) -
+        halfTurns * static_cast<T>(PI_PART3);
+    const T sign = HalfTurnSign(halfTurns);
+    sinValue = sign * FastSin<T, Degree>::Polynomial(r);
+    cosValue = sign * FastSin<T, Degree>::Polynomial(static_cast<T>(PI_DIV_2) - std::abs(r));
+}
+
+template<typename T, int Degree>
+void FastSinCos<T, Degree>::operator()(const T* angles, T* sinValues, T* cosValues, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        (*this)(angles[i], sinValues[i], cosValues[i]);
+}
+
+template<typename T, int Degree>
+inline T FastSinCos<T, Degree>::ReduceQuarterTurns(const T angle, T& quarterTurns)
+{
+    // As in operator(), with the parts of Pi halved (exact, so k * PART is still exact).
+    quarterTurns = std::floor(angle * static_cast<T>(2.0 * INV_PI) + static_cast<T>(0.5));
+    return ((angle - quarterTurns * static_cast<T>(PI_PART1 / 2.0)) - quarterTurns * static_cast<T>(PI_PART2 / 2.0)) -
+        quarterTurns * static_cast<T>(PI_PART3 / 2.0);
+}
+
+template<typename T, int Degree>
+inline void FastSinCos<T, Degree>::SinCosPi(const T x, T& sinValue, T& cosValue) const
+{
+    // Same as operator() but the half turns are removed before multiplying with Pi, so
+    // the subtraction is exact. Also 0.5 - |f| is exact, so cos(Pi/2) is exactly zero.
+    const T halfTurns = std::floor(x + static_cast<T>(0.5));
+    const T f = x - halfTurns;
+    const T sign = HalfTurnSign(halfTurns);
+    sinValue = sign * FastSin<T, Degree>::Polynomial(static_cast<T>(FAST_SIN_PI) * f);
+    cosValue = sign * FastSin<T, Degree>::Polynomial(static_cast<T>(FAST_SIN_PI) * (static_cast<T>(0.5) - std::abs(f)));
+}
+
+template<typename T, int Degree>
+void FastSinCos<T, Degree>::SinCosPi(const T* x, T* sinValues, T* cosValues, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        SinCosPi(x[i], sinValues[i], cosValues[i]);
+}
+
+template<typename T, int Degree>
+inline void FastSinCos<T, Degree>::SinCosDegrees(const T degrees, T& sinValue, T& cosValue) const
+{
+    // As SinCosPi() but the reduction is done in degrees: halfTurns * 180 is exact, and so is
+    // the subtraction and 90 - |r|.
+    const T halfTurns = std::floor(degrees * static_cast<T>(1.0 / 180.0) + static_cast<T>(0.5));
+    const T r = degrees - halfTurns * static_cast<T>(180.0);
+    const T sign = HalfTurnSign(halfTurns);
+    sinValue = sign * FastSin<T, Degree>::Polynomial(static_cast<T>(RADIANS_PER_DEGREE) * r);
+    cosValue = sign * FastSin<T, Degree>::Polynomial(static_cast<T>(RADIANS_PER_DEGREE) * (static_cast<T>(90.0) - std::abs(r)));
+}
+
+template<typename T, int Degree>
+void FastSinCos<T, Degree>::SinCosDegrees(const T* degrees, T* sinValues, T* cosValues, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        SinCosDegrees(degrees[i], sinValues[i], cosValues[i]);
+}
+
+template<typename T, int Degree>
+template<int N>
+inline void FastSinCos<T, Degree>::operator()(const FastDual<T, N>& angle, FastDual<T, N>& sinValue,
+    FastDual<T, N>& cosValue) const
+{
+    T derivatives[N];
+    for (int k = 0; k < N; ++k)
+        derivatives[k] = angle.derivatives[k];
+    T s, c;
+    (*this)(angle.value, s, c);
+    sinValue.value = s;
+    cosValue.value = c;
+    for (int k = 0; k < N; ++k)
     {
-        // degree 7 - Maximum error (*): 9.39101e-07
-        return sign * x1 * (static_cast<T>(0.999999060898976) + x2 * (static_cast<T>(-0.166655540927576) +
-            x2 * (static_cast<T>(0.00831189980138987) - static_cast<T>(0.000184881402886071 * x2))));
+        sinValue.derivatives[k] = c * derivatives[k];
+        cosValue.derivatives[k] = -s * derivatives[k];
     }
-    else if constexpr (Degree == 9)
+}
+
+template<typename T, int Degree>
+template<int N>
+void FastSinCos<T, Degree>::operator()(const FastDual<T, N>* angles, FastDual<T, N>* sinValues,
+    FastDual<T, N>* cosValues, const std::size_t count) const
+{
+    // The values are gathered to a block so that the sine and cosine loop vectorizes also when
+    // the stride of the FastDuals is not a vector width.
+    T values[BLOCK_SIZE], sinBlock[BLOCK_SIZE], cosBlock[BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
     {
-        // degree 9 - Maximum error (*): 5.31399e-09
-        return sign * x1 * (static_cast<T>(0.999999994686007) + x2 * (static_cast<T>(-0.166666566840071) +
-            x2 * (static_cast<T>(0.00833302513896936) + x2 * (static_cast<T>(-0.000198074187274269) +
-                static_cast<T>(2.601903067651460e-6) * x2))));
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        for (std::size_t b = 0; b < size; ++b)
+            values[b] = angles[start + b].value;
+        (*this)(values, sinBlock, cosBlock, size);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            T derivatives[N];
+            for (int k = 0; k < N; ++k)
+                derivatives[k] = angles[start + b].derivatives[k];
+            const T s = sinBlock[b], c = cosBlock[b];
+            sinValues[start + b].value = s;
+            cosValues[start + b].value = c;
+            for (int k = 0; k < N; ++k)
+            {
+                sinValues[start + b].derivatives[k] = c * derivatives[k];
+                cosValues[start + b].derivatives[k] = -s * derivatives[k];
+            }
+        }
     }
 }
 
+template<typename T, int Degree>
+template<int N>
+FastDual<T, N> FastSinCos<T, Degree>::Sin(const FastDual<T, N>& angle) const
+{
+    FastDual<T, N> sinValue, cosValue;
+    (*this)(angle, sinValue, cosValue);
+    return sinValue;
+}
+
+template<typename T, int Degree>
+template<int N>
+FastDual<T, N> FastSinCos<T, Degree>::Cos(const FastDual<T, N>& angle) const
+{
+    FastDual<T, N> sinValue, cosValue;
+    (*this)(angle, sinValue, cosValue);
+    return cosValue;
+}
+
+template<typename T, int Degree>
+T FastSinCos<T, Degree>::Sin(const T angle) const
+{
+    T sinValue, cosValue;
+    (*this)(angle, sinValue, cosValue);
+    return sinValue;
+}
+
+template<typename T, int Degree>
+T FastSinCos<T, Degree>::Cos(const T angle) const
+{
+    T sinValue, cosValue;
+    (*this)(angle, sinValue, cosValue);
+    return cosValue;
+}
+
+template<typename T, int Degree>
+T FastSinCos<T, Degree>::SinPi(const T x) const
+{
+    T sinValue, cosValue;
+    SinCosPi(x, sinValue, cosValue);
+    return sinValue;
+}
+
+template<typename T, int Degree>
+T FastSinCos<T, Degree>::CosPi(const T x) const
+{
+    T sinValue, cosValue;
+    SinCosPi(x, sinValue, cosValue);
+    return cosValue;
+}
+
+template<typename T, int Degree>
+inline T FastSinCos<T, Degree>::HalfTurnSign(const T halfTurns)
+{
+    const T half = halfTurns * static_cast<T>(0.5);
+    return static_cast<T>(1.0) - static_cast<T>(4.0) * (half - std::floor(half));
+}
+
 #endif // __FAST_SIN__
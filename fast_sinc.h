@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. classes FastSinc and FastPolyphaseSinc added.
+// 17/10/26: FastSinc uses the series near 0, FastPolyphaseSinc checks its arguments.
+//
+
+#ifndef __FAST_SINC__
+#define __FAST_SINC__
+
+#include "fast_sin.h"
+#include "fast_window.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+// FastSinc: A class to calculate the normalized sinc function sin(Pi * x) / (Pi * x).
+// T, Degree: as in FastSin.
+//   The sine is calculated with FastSinCos::SinPi(), so the reduction is exact. Near 0 the
+// polynomial gives sin(Pi * x) / (Pi * x) = c0 (e.g. 1 - 9.4e-07 for Degree 7), not 1, so below
+// SMALL_X the series 1 - (Pi * x)^2 / 6 is used instead: it tends to 1 and its truncation error
+// (Pi * x)^4 / 120 is there below the maximum error of FastSin. The two are selected (compiled
+// to blend instructions, not branches), so the batch version can be vectorized.
+//
+// Usage example:
+// FastSinc<float> sinc;
+// auto value = sinc(0.37f);
+//
+template<typename T = double, int Degree = 7>
+class FastSinc
+{
+public:
+    // x: the argument (not multiplied with Pi)
+    // returns: sin(Pi * x) / (Pi * x), and 1 for x = 0
+    T operator()(T x) const;
+
+    // Batch version: calculates sinc for @count values.
+    void operator()(const T* x, T* out, std::size_t count) const;
+
+private:
+    inline const static double FAST_SIN_PI{ 3.141592653589793 };
+    // The limit of the series: (Pi * SMALL_X)^4 / 120 is the maximum error of FastSin<T, Degree>.
+    inline const static T SMALL_X{ static_cast<T>(std::sqrt(std::sqrt(120.0 * (Degree == 7 ? 9.39102e-07 :
+        Degree == 9 ? 5.31400e-09 : Degree == 11 ? 2.11510e-11 : Degree == 13 ? 6.26804e-14 : 4.19641e-16))) /
+        FAST_SIN_PI) };
+};
+
+template<typename T, int Degree>
+T FastSinc<T, Degree>::operator()(const T x) const
+{
+    const T sinValue = FastSinCos<T, Degree>().SinPi(x);
+    const T piX = static_cast<T>(FAST_SIN_PI) * x;
+    // Both operands are selected so that there is no 0/0 at x = 0.
+    const bool isSmall = std::abs(x) < SMALL_X;
+    const T numerator = isSmall ? static_cast<T>(1.0) - piX * piX * static_cast<T>(1.0 / 6.0) : sinValue;
+    const T denominator = isSmall ? static_cast<T>(1.0) : piX;
+    return numerator / denominator;
+}
+
+template<typename T, int Degree>
+void FastSinc<T, Degree>::operator()(const T* const x, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(x[i]);
+}
+
+// FastPolyphaseSinc: A class to build the coefficient table of a windowed-sinc polyphase
+// resampling filter.
+// T, Degree: as in FastSin.
+//   Phase p (0..phases-1) is the filter for the fractional delay p/phases. Its tap k
+// (0..tapsPerPhase-1) is at the distance t = k - (tapsPerPhase/2 - 1) - p/phases from the
+// output position and has the value cutoff * sinc(cutoff * t) * w(t), where w is a FastWindow
+// spanning tapsPerPhase samples. Each phase is normalized to unity DC gain, so the gain does
+// not ripple with the fractional delay. The constructor checks the arguments (see below), and
+// with them the taps at |t| <= 1 are positive and dominate the sum, so the DC gain that is
+// divided by is positive (at least 0.09 * cutoff for tapsPerPhase = 2 and a Kaiser window with
+// beta = 20, more for the other windows and longer filters).
+//   cutoff is relative to the input Nyquist frequency: use 1 for upsampling and
+// outputRate / inputRate (a bit less for a transition band) for downsampling.
+//
+// Usage example:
+// FastPolyphaseSinc<float> filter(64, 16, 0.9f);
+// std::vector<float> taps(64 * 16);
+// filter.Build(taps.data());
+//
+template<typename T = double, int Degree = 7>
+class FastPolyphaseSinc
+{
+public:
+    // phases: number of fractional delays, at least 1
+    // tapsPerPhase: filter length of one phase, even and at least 2
+    // cutoff: cutoff frequency relative to the input Nyquist frequency, (0, 1]
+    // windowType, kaiserBeta: the window (see FastWindow), kaiserBeta in [0, 20]
+    // Other arguments throw std::invalid_argument.
+    FastPolyphaseSinc(std::size_t phases, std::size_t tapsPerPhase, T cutoff,
+        FastWindowType windowType = FastWindowType::BlackmanHarris, T kaiserBeta = static_cast<T>(8.6));
+
+    // taps: returns phases * tapsPerPhase values: taps[p * tapsPerPhase + k] is tap k of phase p
+    void Build(T* taps) const;
+
+private:
+    std::size_t m_phases;
+    std::size_t m_tapsPerPhase;
+    T m_cutoff;
+    // periodic window over tapsPerPhase samples, so its period is tapsPerPhase
+    FastWindow<T, Degree> m_window;
+};
+
+template<typename T, int Degree>
+FastPolyphaseSinc<T, Degree>::FastPolyphaseSinc(const std::size_t phases, const std::size_t tapsPerPhase,
+    const T cutoff, const FastWindowType windowType, const T kaiserBeta) :
+    m_phases{ phases },
+    m_tapsPerPhase{ tapsPerPhase },
+    m_cutoff{ cutoff },
+    m_window{ windowType, tapsPerPhase, true, kaiserBeta }
+{
+    if (phases == 0 || tapsPerPhase == 0 || tapsPerPhase % 2 != 0)
+        throw std::invalid_argument("FastPolyphaseSinc: phases must be at least 1 and tapsPerPhase even");
+    if (!(cutoff > static_cast<T>(0.0) && cutoff <= static_cast<T>(1.0)))
+        throw std::invalid_argument("FastPolyphaseSinc: cutoff must be in (0, 1]");
+    if (windowType == FastWindowType::Kaiser &&
+        !(kaiserBeta >= static_cast<T>(0.0) && kaiserBeta <= static_cast<T>(20.0)))
+        throw std::invalid_argument("FastPolyphaseSinc: kaiserBeta must be in [0, 20]");
+}
+
+template<typename T, int Degree>
+void FastPolyphaseSinc<T, Degree>::Build(T* const taps) const
+{
+    const FastSinc<T, Degree> sinc;
+    const T halfLength = static_cast<T>(m_tapsPerPhase / 2);
+    for (std::size_t p = 0; p < m_phases; ++p)
+    {
+        T* const phaseTaps = taps + p * m_tapsPerPhase;
+        const T delay = static_cast<T>(p) / static_cast<T>(m_phases);
+        T sum = static_cast<T>(0.0);
+        for (std::size_t k = 0; k < m_tapsPerPhase; ++k)
+        {
+            const T t = static_cast<T>(k) - (halfLength - static_cast<T>(1.0)) - delay;
+            const T tap = m_cutoff * sinc(m_cutoff * t) * m_window(t + halfLength);
+            phaseTaps[k] = tap;
+            sum += tap;
+        }
+        const T scale = static_cast<T>(1.0) / sum;
+        for (std::size_t k = 0; k < m_tapsPerPhase; ++k)
+            phaseTaps[k] *= scale;
+    }
+}
+
+#endif // __FAST_SINC__
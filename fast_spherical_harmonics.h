@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastSphericalHarmonics added.
+//
+
+#ifndef __FAST_SPHERICAL_HARMONICS__
+#define __FAST_SPHERICAL_HARMONICS__
+
+#include "fast_sin.h"
+
+#include <cmath>
+#include <cstddef>
+
+// FastSphericalHarmonics: A class to evaluate the real spherical harmonics Y_lm, l = 0..L,
+// m = -l..l, for many directions at once.
+// T, Degree: as in FastSin.
+//   The harmonics are orthonormal on the unit sphere:
+//   Y_l0 = K_l0 * P_l0(cos(theta))
+//   Y_lm = sqrt(2) * K_lm * P_lm(cos(theta)) * cos(m * phi), m > 0
+//   Y_lm = sqrt(2) * K_l|m| * P_l|m|(cos(theta)) * sin(|m| * phi), m < 0
+// where K_lm = sqrt((2l + 1) / (4 * Pi) * (l - m)! / (l + m)!) and P_lm are the associated
+// Legendre functions without the Condon-Shortley phase (-1)^m (it can be included with the
+// constructor argument).
+//   FastSinCos is called once for theta and once for phi. The rest is recurrences: with
+// x + iy = sin(theta) * (cos(phi) + i * sin(phi)), (x + iy)^m gives both sin^m(theta) * cos(m * phi)
+// and sin^m(theta) * sin(m * phi), and the normalized P_lm(z) / sin^m(theta) is a polynomial in
+// z = cos(theta) with the three-term recurrence in l. The normalization is in the recurrence
+// coefficients, so there are no factorials and nothing overflows (also with float). L is a
+// template parameter, so all the loop counts are constants: the directions are processed in
+// blocks of BLOCK_SIZE with one short branch-free loop per recurrence step, which the compiler
+// vectorizes (see FastSinCos for the compiler options).
+//   The output is (L + 1)^2 SoA planes in the ACN order: Y_lm of direction n is at
+// out[(l * (l + 1) + m) * planeStride + n].
+//
+// Usage example:
+// FastSphericalHarmonics<3, float> harmonics; // 16 coefficients
+// harmonics(theta, phi, coefficients, count);
+//
+template<int L, typename T = double, int Degree = 7>
+class FastSphericalHarmonics
+{
+public:
+    // condonShortleyPhase: true to multiply Y_lm with (-1)^m (the physics convention)
+    explicit FastSphericalHarmonics(bool condonShortleyPhase = false);
+
+    // theta: @count polar angles (from the +z axis) in radians
+    // phi: @count azimuth angles (from the +x axis towards +y) in radians
+    // out: returns (L + 1)^2 planes of harmonics
+    // planeStride: distance of the planes in values, 0 = @count
+    void operator()(const T* theta, const T* phi, T* out, std::size_t count, std::size_t planeStride = 0) const;
+
+    // The number of harmonics (output planes)
+    inline const static int COEFFICIENTS{ (L + 1) * (L + 1) };
+
+private:
+    static_assert(L >= 0, "FastSphericalHarmonics: L must be at least 0");
+
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+    inline const static double FAST_SH_PI{ 3.141592653589793 };
+
+    // The normalized values Q_lm = Y_lm / (sin^m(theta) * cos(m * phi)) (without sqrt(2) for
+    // m = 0) follow Q_mm = m_diagonal[m], Q_(m+1)m = m_a[index] * z * Q_mm and
+    // Q_lm = m_a[index] * z * Q_(l-1)m - m_b[index] * Q_(l-2)m, index = l * (l + 1) + m.
+    T m_diagonal[L + 1];
+    T m_a[COEFFICIENTS];
+    T m_b[COEFFICIENTS];
+};
+
+template<int L, typename T, int Degree>
+FastSphericalHarmonics<L, T, Degree>::FastSphericalHarmonics(const bool condonShortleyPhase)
+{
+    // Q_mm = sqrt((2m + 1) / (2m)) * Q_(m-1)(m-1), Q_00 = sqrt(1 / (4 * Pi)), times sqrt(2) for m > 0.
+    double diagonal = std::sqrt(1.0 / (4.0 * FAST_SH_PI));
+    for (int m = 0; m <= L; ++m)
+    {
+        if (m > 0)
+            diagonal *= std::sqrt((2.0 * m + 1.0) / (2.0 * m));
+        const double sign = condonShortleyPhase && m % 2 == 1 ? -1.0 : 1.0;
+        m_diagonal[m] = static_cast<T>(sign * (m > 0 ? std::sqrt(2.0) : 1.0) * diagonal);
+    }
+    for (int l = 0; l <= L; ++l)
+    {
+        for (int m = 0; m <= l; ++m)
+        {
+            const int index = l * (l + 1) + m;
+            const double l2 = static_cast<double>(l) * l, m2 = static_cast<double>(m) * m;
+            m_a[index] = static_cast<T>(l > m ? std::sqrt((4.0 * l2 - 1.0) / (l2 - m2)) : 0.0);
+            m_b[index] = static_cast<T>(l > m + 1 ? std::sqrt(((l - 1.0) * (l - 1.0) - m2) * (2.0 * l + 1.0) /
+                ((2.0 * l - 3.0) * (l2 - m2))) : 0.0);
+        }
+    }
+}
+
+template<int L, typename T, int Degree>
+void FastSphericalHarmonics<L, T, Degree>::operator()(const T* const theta, const T* const phi, T* const out,
+    const std::size_t count, std::size_t planeStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    if (planeStride == 0)
+        planeStride = count;
+    T z[BLOCK_SIZE], sinTheta[BLOCK_SIZE], x[BLOCK_SIZE], y[BLOCK_SIZE];
+    T real[BLOCK_SIZE], imaginary[BLOCK_SIZE];
+    T buffers[3][BLOCK_SIZE];
+    for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+    {
+        const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+        sinCos(theta + start, sinTheta, z, size);
+        sinCos(phi + start, y, x, size);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            x[b] *= sinTheta[b];
+            y[b] *= sinTheta[b];
+            // (x + iy)^0
+            real[b] = static_cast<T>(1.0);
+            imaginary[b] = static_cast<T>(0.0);
+        }
+        for (int m = 0; m <= L; ++m)
+        {
+            // Q_lm for l = m..L in three rotating buffers, written to the planes (l, m) and (l, -m).
+            T* previous2 = buffers[0];
+            T* previous1 = buffers[1];
+            T* current = buffers[2];
+            for (int l = m; l <= L; ++l)
+            {
+                const int index = l * (l + 1) + m;
+                const T a = m_a[index], bValue = m_b[index], diagonal = m_diagonal[m];
+                if (l == m)
+                {
+                    for (std::size_t b = 0; b < size; ++b)
+                        current[b] = diagonal;
+                }
+                else if (l == m + 1)
+                {
+                    for (std::size_t b = 0; b < size; ++b)
+                        current[b] = a * z[b] * previous1[b];
+                }
+                else
+                {
+                    for (std::size_t b = 0; b < size; ++b)
+                        current[b] = a * z[b] * previous1[b] - bValue * previous2[b];
+                }
+                T* const cosPlane = out + static_cast<std::size_t>(index) * planeStride + start;
+                if (m == 0)
+                {
+                    for (std::size_t b = 0; b < size; ++b)
+                        cosPlane[b] = current[b];
+                }
+                else
+                {
+                    T* const sinPlane = out + static_cast<std::size_t>(index - 2 * m) * planeStride + start;
+                    for (std::size_t b = 0; b < size; ++b)
+                    {
+                        cosPlane[b] = current[b] * real[b];
+                        sinPlane[b] = current[b] * imaginary[b];
+                    }
+                }
+                T* const oldest = previous2;
+                previous2 = previous1;
+                previous1 = current;
+                current = oldest;
+            }
+            // (x + iy)^(m + 1)
+            for (std::size_t b = 0; b < size; ++b)
+            {
+                const T nextReal = real[b] * x[b] - imaginary[b] * y[b];
+                imaginary[b] = real[b] * y[b] + imaginary[b] * x[b];
+                real[b] = nextReal;
+            }
+        }
+    }
+}
+
+#endif // __FAST_SPHERICAL_HARMONICS__
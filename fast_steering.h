@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastSteering added.
+//
+
+#ifndef __FAST_STEERING__
+#define __FAST_STEERING__
+
+#include "fast_sin.h"
+
+#include <cmath>
+#include <cstddef>
+
+// FastSteering: A class to generate the steering vectors of a uniform linear array:
+//   a[m](angle) = exp(-i*2*Pi*spacing*m*sin(angle)), m = 0..elements-1
+// where spacing is the element spacing in wavelengths (d / lambda) and the angle is measured
+// from the array broadside.
+// T, Degree: as in FastSin.
+//   sin(angle) is calculated once per scan angle, in double with the degree 15 polynomial
+// because the element index multiplies its error. The first LANES elements of every resync
+// interval are calculated directly with FastSinCos, the rest with the complex rotation
+// a[m] = a[m - LANES] * exp(-i*2*Pi*spacing*LANES*sin(angle)). The recurrence step is LANES
+// elements, so consecutive elements are independent and the loop can be vectorized.
+//   The output is split complex, one row per scan angle (re[a * rowStride + m]), which is the
+// layout a GEMV needs to form all beams from one snapshot. A @rowStride larger than the number
+// of elements can be used to pad the rows for alignment.
+//
+// Usage example:
+// FastSteering<float> steering(64, 0.5f); // 64 elements, half wavelength spacing
+// steering(angles, 181, re, im);          // 181 x 64 steering matrix
+//
+template<typename T = double, int Degree = 7>
+class FastSteering
+{
+public:
+    // elements: number of array elements
+    // spacing: element spacing in wavelengths
+    // resyncInterval: number of elements between the directly calculated ones (rounded to LANES)
+    FastSteering(std::size_t elements, T spacing, std::size_t resyncInterval = 64);
+
+    // angles: @count scan angles in radians
+    // re, im: return the steering vectors, row a at re + a * rowStride
+    // rowStride: distance of the rows in values, 0 = number of elements
+    void operator()(const T* angles, std::size_t count, T* re, T* im, std::size_t rowStride = 0) const;
+
+private:
+    inline const static std::size_t LANES{ 8 };
+
+    std::size_t m_elements;
+    double m_spacing;
+    std::size_t m_resyncInterval;
+};
+
+template<typename T, int Degree>
+FastSteering<T, Degree>::FastSteering(const std::size_t elements, const T spacing, const std::size_t resyncInterval) :
+    m_elements{ elements },
+    m_spacing{ static_cast<double>(spacing) },
+    m_resyncInterval{ resyncInterval < LANES ? LANES : resyncInterval - resyncInterval % LANES }
+{
+}
+
+template<typename T, int Degree>
+void FastSteering<T, Degree>::operator()(const T* const angles, const std::size_t count, T* const re, T* const im,
+    std::size_t rowStride) const
+{
+    const FastSinCos<T, Degree> sinCos;
+    const FastSinCos<double, 15> angleSinCos;
+    const std::size_t elements = m_elements;
+    const std::size_t resyncInterval = m_resyncInterval;
+    if (rowStride == 0)
+        rowStride = elements;
+    for (std::size_t a = 0; a < count; ++a)
+    {
+        T* const rowRe = re + a * rowStride;
+        T* const rowIm = im + a * rowStride;
+        double sinAngle, cosAngle;
+        angleSinCos(static_cast<double>(angles[a]), sinAngle, cosAngle);
+        // The phase of one element step in half turns: -2*spacing*sin(angle). The phases are
+        // calculated and wrapped in double, so that float keeps its accuracy for long arrays.
+        const double step = -2.0 * m_spacing * sinAngle;
+        double rotationHalfTurns = static_cast<double>(LANES) * step;
+        rotationHalfTurns -= 2.0 * std::floor(0.5 * rotationHalfTurns + 0.5);
+        T rotationSin, rotationCos;
+        sinCos.SinCosPi(static_cast<T>(rotationHalfTurns), rotationSin, rotationCos);
+
+        for (std::size_t start = 0; start < elements; start += resyncInterval)
+        {
+            const std::size_t end = start + resyncInterval < elements ? start + resyncInterval : elements;
+            const std::size_t directEnd = start + LANES < end ? start + LANES : end;
+            for (std::size_t m = start; m < directEnd; ++m)
+            {
+                double halfTurns = static_cast<double>(static_cast<int>(m)) * step;
+                halfTurns -= 2.0 * std::floor(0.5 * halfTurns + 0.5);
+                sinCos.SinCosPi(static_cast<T>(halfTurns), rowIm[m], rowRe[m]);
+            }
+            for (std::size_t m = directEnd; m < end; ++m)
+            {
+                const T previousRe = rowRe[m - LANES];
+                const T previousIm = rowIm[m - LANES];
+                rowRe[m] = previousRe * rotationCos - previousIm * rotationSin;
+                rowIm[m] = previousRe * rotationSin + previousIm * rotationCos;
+            }
+        }
+    }
+}
+
+#endif // __FAST_STEERING__
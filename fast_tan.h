@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastTan added.
+// 17/10/26: FastTan::Polynomials() evaluated with FastPolynomial (fast_polynomial.h).
+//
+
+#ifndef __FAST_TAN__
+#define __FAST_TAN__
+
+#include "fast_polynomial.h"
+#include "fast_sin.h"
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// FastTan: A class to calculate mathematical tan for a given angle in radians.
+// T: The type of the calculations/return value (double/float)
+// Degree: the degree of the sine polynomial (the cosine polynomial is one lower).
+// Can be 5, 7, 9, 11 or 13 (higher is more accurate).
+// Maximum relative error for Degree 5: 1.28486e-05
+// Maximum relative error for Degree 7: 3.46005e-08
+// Maximum relative error for Degree 9: 5.86206e-11
+// Maximum relative error for Degree 11: 6.83975e-14
+// Maximum relative error for Degree 13: 4.42024e-16 (use with double, close to the accuracy of std::tan())
+// (float gives 1.03e-06 from Degree 7, measured in [-20, 20].)
+//   The angle is reduced with the nearest whole number of quarter turns (the reduction of
+// FastSinCos, FastSinCos::ReduceQuarterTurns()), so r is in [-Pi/4, Pi/4]. There sin(r) and
+// cos(r) are a pair of short MiniMax polynomials, and tan(angle) = sin(r) / cos(r) for an even
+// number of quarter turns and -cos(r) / sin(r) (the cotangent identity) for an odd number. The numerator and the
+// denominator are selected first, so there is one reduction and one division and no branches,
+// and the batch version can be vectorized (e.g. -O3 -march=native).
+//   The poles need no special case: near an odd multiple of Pi/2 sin(r) is small but has the
+// full relative accuracy, so the result is the large value with the same relative error (plus
+// up to 1.5e-15 from the reduction with double). Only if r is exactly zero the result is
+// +-infinity.
+//
+// Usage example:
+// FastTan<double, 9> fastTan;
+// auto value = fastTan(1.2);
+// fastTan(angles, values, count); // batch
+//
+template<typename T = double, int Degree = 7>
+class FastTan
+{
+public:
+    // angle: in radians
+    // returns: tan(@angle)
+    T operator()(T angle) const;
+
+    // Batch version: calculates tan for @count angles.
+    void operator()(const T* angles, T* out, std::size_t count) const;
+
+    // r: angle in [-Pi/4, Pi/4]
+    // sinValue, cosValue: returns the polynomial approximations of sin(@r) and cos(@r). No
+    // argument reduction is done.
+    static void Polynomials(T r, T& sinValue, T& cosValue);
+
+private:
+    static_assert(Degree == 5 || Degree == 7 || Degree == 9 || Degree == 11 || Degree == 13,
+        "FastTan: Degree must be 5, 7, 9, 11 or 13");
+
+    // The coefficients of S(z) and C(z) (see Polynomials()).
+    struct SinCoefficients5
+    {
+        // degree 5 - Maximum relative error of sin in [-Pi/4, Pi/4]: 1.86382e-06
+        inline constexpr static double VALUES[]{ -0.166633903772913122, 0.00816328192090389100 };
+    };
+    struct SinCoefficients7
+    {
+        // degree 7 - Maximum relative error of sin in [-Pi/4, Pi/4]: 3.79108e-09
+        inline constexpr static double VALUES[]{ -0.166666546095485923, 0.00833216076185904105,
+            -0.000195152831920360621 };
+    };
+    struct SinCoefficients9
+    {
+        // degree 9 - Maximum relative error of sin in [-Pi/4, Pi/4]: 5.15748e-12
+        inline constexpr static double VALUES[]{ -0.166666666407970482, 0.00833332930484256308,
+            -0.000198393122694562568, 2.71812162754797321e-06 };
+    };
+    struct SinCoefficients11
+    {
+        // degree 11 - Maximum relative error of sin in [-Pi/4, Pi/4]: 4.99912e-15
+        inline constexpr static double VALUES[]{ -0.166666666666303503, 0.00833333332507777379,
+            -0.000198412637286341588, 2.75553396564504438e-06, -2.47604545657587203e-08 };
+    };
+    struct SinCoefficients13
+    {
+        // degree 13 - Maximum relative error of sin in [-Pi/4, Pi/4]: 3.62054e-18
+        inline constexpr static double VALUES[]{ -0.166666666666666297, 0.00833333333332211823,
+            -0.000198412698295895388, 2.75573136213856759e-06, -2.50507477628503553e-08, 1.58962301572218438e-10 };
+    };
+    struct CosCoefficients5
+    {
+        // degree 5 - Maximum relative error of cos in [-Pi/4, Pi/4]: 1.47011e-05
+        inline constexpr static double VALUES[]{ -0.499760557086441570, 0.0404584522647571942 };
+    };
+    struct CosCoefficients7
+    {
+        // degree 7 - Maximum relative error of cos in [-Pi/4, Pi/4]: 3.83635e-08
+        inline constexpr static double VALUES[]{ -0.499998847458762607, 0.0416557770416983858,
+            -0.00135918535516691840 };
+    };
+    struct CosCoefficients9
+    {
+        // degree 9 - Maximum relative error of cos in [-Pi/4, Pi/4]: 6.37410e-11
+        inline constexpr static double VALUES[]{ -0.499999996944759661, 0.0416666203571296467, -0.00138866816479499733,
+            2.43835673099342287e-05 };
+    };
+    struct CosCoefficients11
+    {
+        // degree 11 - Maximum relative error of cos in [-Pi/4, Pi/4]: 7.29941e-14
+        inline constexpr static double VALUES[]{ -0.499999999994893807, 0.0416666665534274130, -0.00138888806594313248,
+            2.47989607347811034e-05, -2.71747899070130235e-07 };
+    };
+    struct CosCoefficients13
+    {
+        // degree 13 - Maximum relative error of cos in [-Pi/4, Pi/4]: 6.09887e-17
+        inline constexpr static double VALUES[]{ -0.499999999999994116, 0.0416666666664878491, -0.00138888888705916919,
+            2.48015786493503987e-05, -2.75552424089023858e-07, 2.06306363991865153e-09 };
+    };
+    using SinCoefficients = typename std::conditional<Degree == 5, SinCoefficients5,
+        typename std::conditional<Degree == 7, SinCoefficients7,
+        typename std::conditional<Degree == 9, SinCoefficients9,
+        typename std::conditional<Degree == 11, SinCoefficients11, SinCoefficients13>::type>::type>::type>::type;
+    using CosCoefficients = typename std::conditional<Degree == 5, CosCoefficients5,
+        typename std::conditional<Degree == 7, CosCoefficients7,
+        typename std::conditional<Degree == 9, CosCoefficients9,
+        typename std::conditional<Degree == 11, CosCoefficients11, CosCoefficients13>::type>::type>::type>::type;
+
+};
+
+template<typename T, int Degree>
+inline T FastTan<T, Degree>::operator()(const T angle) const
+{
+    T quarterTurns;
+    const T r = FastSinCos<T>::ReduceQuarterTurns(angle, quarterTurns);
+    T sinValue, cosValue;
+    Polynomials(r, sinValue, cosValue);
+    // Odd quarter turns: the fraction of quarterTurns / 2 is 0.5.
+    const T half = quarterTurns * static_cast<T>(0.5);
+    const bool isOdd = half - std::floor(half) > static_cast<T>(0.25);
+    const T numerator = isOdd ? -cosValue : sinValue;
+    const T denominator = isOdd ? sinValue : cosValue;
+    return numerator / denominator;
+}
+
+template<typename T, int Degree>
+void FastTan<T, Degree>::operator()(const T* const angles, T* const out, const std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = (*this)(angles[i]);
+}
+
+template<typename T, int Degree>
+inline void FastTan<T, Degree>::Polynomials(const T r, T& sinValue, T& cosValue)
+{
+    // sin(r) = r + r * z * S(z) and cos(r) = 1 + z * C(z), z = r^2, fitted for relative error.
+    const T z = r * r;
+    sinValue = r + r * z * FastPolynomial<SinCoefficients>::Evaluate(z);
+    cosValue = static_cast<T>(1.0) + z * FastPolynomial<CosCoefficients>::Evaluate(z);
+}
+
+#endif // __FAST_TAN__
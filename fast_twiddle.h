@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastTwiddles added.
+// 17/10/26: Quarter and half turn symmetries for N not divisible by 8, the float table from
+// anchors and steps, and the checks of count and Radix4().
+//
+
+#ifndef __FAST_TWIDDLE__
+#define __FAST_TWIDDLE__
+
+#include "fast_sin.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// FastTwiddles: A class to generate FFT twiddle factor tables W^k = exp(-2*Pi*i*k/N)
+// (or exp(+2*Pi*i*k/N) for the inverse transform).
+// T: The type of the calculations/table values (double/float)
+// Degree: the degree of the FastSin polynomial approximation (see fast_sin.h).
+// For double FFTs use Degree 15 (maximum error about 4e-16), for float FFTs Degree 7
+// is the fastest and accurate to about 2e-6.
+//   Only a part of the circle is calculated with the polynomial, using FastSinCos::SinCosPi()
+// so that the angle 2*Pi*k/N has no reduction error, and all other values are mirrored from
+// it through the symmetries of sin and cos:
+//   N divisible by 8: the first eighth (k = 0..N/8), the other octants are mirrored
+//   N divisible by 4: the first quarter (k = 0..N/4), the other quadrants are rotated
+//   otherwise: the first half (k = 0..N/2), W^(N-k) is the conjugate of W^k
+// The mirroring is done one part at a time, so the inner loops are plain copies with a fixed
+// sign and direction.
+//   double calculates every table value with the polynomials. float is optimized for speed:
+// only every FLOAT_STEPS-th value (the anchors) and the FLOAT_STEPS first values (the steps)
+// are calculated with the polynomials, the rest are the products anchor * step (one complex
+// multiplication instead of two polynomials). The error is then at most about twice the
+// polynomial error.
+//
+// Layouts:
+//   Interleaved(): out[2k] = Re(W^k), out[2k+1] = Im(W^k), k = 0..count-1
+//   Split(): re[k] = Re(W^k), im[k] = Im(W^k), k = 0..count-1
+//   Radix4(): the three twiddles W^k, W^2k, W^3k of a radix-4 butterfly for k = 0..N/4-1:
+//     out[6k..6k+5] = Re(W^k), Im(W^k), Re(W^2k), Im(W^2k), Re(W^3k), Im(W^3k)
+//
+// Usage example:
+// FastTwiddles<double, 15> twiddles(1024);
+// std::vector<double> table(2 * 1024);
+// twiddles.Interleaved(table.data(), 1024);
+//
+template<typename T = double, int Degree = 7>
+class FastTwiddles
+{
+public:
+    // n: the FFT size N, at least 1 (0 throws std::invalid_argument)
+    // inverse: false for exp(-2*Pi*i*k/N), true for exp(+2*Pi*i*k/N)
+    explicit FastTwiddles(std::size_t n, bool inverse = false);
+
+    // out: 2 * @count values, count: number of twiddles (at most N, more throws
+    // std::invalid_argument)
+    void Interleaved(T* out, std::size_t count) const;
+
+    // re, im: @count values each, count: number of twiddles (at most N, more throws
+    // std::invalid_argument)
+    void Split(T* re, T* im, std::size_t count) const;
+
+    // out: 6 * (N / 4) values. N must be divisible by 4 (otherwise throws std::logic_error).
+    void Radix4(T* out) const;
+
+    // k: twiddle index (any value, it is taken modulo N)
+    // re, im: returns the real and imaginary parts of W^k
+    void Twiddle(std::size_t k, T& re, T& im) const;
+
+private:
+    // A part of the circle mirrored from the table: W^k for k = first..first+length-1 is
+    // (cosSign * a[i], imSign * b[i]), i = start +- (k - first) (- if reversed), where a and b
+    // are the cos and sin tables (the other way around if swapped).
+    struct Segment
+    {
+        std::size_t first;
+        std::size_t length;
+        std::size_t start;
+        bool reversed;
+        bool swapped;
+        T cosSign;
+        T imSign;
+    };
+
+    // Calls func(k, re, im) for k = 0..count-1 going through the segments in order.
+    template<typename Func>
+    void ForEach(std::size_t count, Func func) const;
+
+    // count: number of twiddles, checked against N
+    void CheckCount(std::size_t count) const;
+
+    // Calculates cos and sin of 2*Pi*j/N for j = 0..m_length.
+    void CalculateTable();
+
+    inline const static std::size_t FLOAT_STEPS{ 32 };
+
+    std::size_t m_n;
+    // the last index of the table (N/8, N/4 or N/2 rounded down)
+    std::size_t m_length;
+    Segment m_segments[8];
+    std::size_t m_segmentCount;
+    // cos and sin of 2*Pi*j/N for j = 0..m_length
+    std::vector<T> m_cos;
+    std::vector<T> m_sin;
+};
+
+template<typename T, int Degree>
+FastTwiddles<T, Degree>::FastTwiddles(const std::size_t n, const bool inverse) :
+    m_n{ n }
+{
+    if (m_n == 0)
+        throw std::invalid_argument("FastTwiddles: the FFT size must be at least 1");
+    const T imSign = static_cast<T>(inverse ? 1.0 : -1.0);
+    const T one = static_cast<T>(1.0);
+    if (m_n % 8 == 0)
+    {
+        // Octant o is o*Pi/4 + a, a = 2*Pi*j/N in [0, Pi/4). The odd octants are mirrored:
+        // o*Pi/4 + a = (o+1)*Pi/4 - b where b = 2*Pi*(N/8 - j)/N. Octants 1, 2, 5 and 6 swap
+        // cos and sin, 2..5 negate cos and 4..7 negate sin.
+        m_length = m_n / 8;
+        m_segmentCount = 8;
+        for (std::size_t o = 0; o < 8; ++o)
+        {
+            const bool reversed = o % 2 == 1;
+            m_segments[o] = { o * m_length, m_length, reversed ? m_length : 0, reversed,
+                o == 1 || o == 2 || o == 5 || o == 6, o >= 2 && o <= 5 ? -one : one, o >= 4 ? -imSign : imSign };
+        }
+    }
+    else if (m_n % 4 == 0)
+    {
+        // Quadrant q is q*Pi/2 + a, a = 2*Pi*j/N in [0, Pi/2): the odd quadrants swap cos and
+        // sin, quadrants 1 and 2 negate cos and 2 and 3 negate sin.
+        m_length = m_n / 4;
+        m_segmentCount = 4;
+        for (std::size_t q = 0; q < 4; ++q)
+            m_segments[q] = { q * m_length, m_length, 0, false, q % 2 == 1, q == 1 || q == 2 ? -one : one,
+                q >= 2 ? -imSign : imSign };
+    }
+    else
+    {
+        // The first half directly, the second half as the conjugates W^(N-k) of the first.
+        m_length = m_n / 2;
+        m_segmentCount = 2;
+        m_segments[0] = { 0, m_length + 1, 0, false, false, one, imSign };
+        m_segments[1] = { m_length + 1, m_n - m_length - 1, m_n - m_length - 1, true, false, one, -imSign };
+    }
+    CalculateTable();
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::Interleaved(T* const out, const std::size_t count) const
+{
+    CheckCount(count);
+    ForEach(count, [out](const std::size_t k, const T re, const T im)
+        {
+            out[2 * k] = re;
+            out[2 * k + 1] = im;
+        });
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::Split(T* const re, T* const im, const std::size_t count) const
+{
+    CheckCount(count);
+    ForEach(count, [re, im](const std::size_t k, const T reValue, const T imValue)
+        {
+            re[k] = reValue;
+            im[k] = imValue;
+        });
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::Radix4(T* const out) const
+{
+    if (m_n % 4 != 0)
+        throw std::logic_error("FastTwiddles: Radix4() needs an FFT size divisible by 4");
+    const std::size_t quarter = m_n / 4;
+    for (std::size_t k = 0; k < quarter; ++k)
+    {
+        Twiddle(k, out[6 * k], out[6 * k + 1]);
+        Twiddle(2 * k, out[6 * k + 2], out[6 * k + 3]);
+        Twiddle(3 * k, out[6 * k + 4], out[6 * k + 5]);
+    }
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::Twiddle(std::size_t k, T& re, T& im) const
+{
+    k %= m_n;
+    const std::size_t index = m_segmentCount == 2 ? (k <= m_length ? 0 : 1) : k / m_length;
+    const Segment& segment = m_segments[index];
+    const std::size_t offset = k - segment.first;
+    const std::size_t i = segment.reversed ? segment.start - offset : segment.start + offset;
+    re = segment.cosSign * (segment.swapped ? m_sin[i] : m_cos[i]);
+    im = segment.imSign * (segment.swapped ? m_cos[i] : m_sin[i]);
+}
+
+template<typename T, int Degree>
+template<typename Func>
+void FastTwiddles<T, Degree>::ForEach(const std::size_t count, Func func) const
+{
+    for (std::size_t s = 0; s < m_segmentCount && m_segments[s].first < count; ++s)
+    {
+        const Segment& segment = m_segments[s];
+        const std::size_t length = count - segment.first < segment.length ? count - segment.first : segment.length;
+        const T* const a = segment.swapped ? m_sin.data() : m_cos.data();
+        const T* const b = segment.swapped ? m_cos.data() : m_sin.data();
+        const T cosSign = segment.cosSign, imSign = segment.imSign;
+        if (segment.reversed)
+        {
+            for (std::size_t j = 0; j < length; ++j)
+                func(segment.first + j, cosSign * a[segment.start - j], imSign * b[segment.start - j]);
+        }
+        else
+        {
+            for (std::size_t j = 0; j < length; ++j)
+                func(segment.first + j, cosSign * a[segment.start + j], imSign * b[segment.start + j]);
+        }
+    }
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::CheckCount(const std::size_t count) const
+{
+    if (count > m_n)
+        throw std::invalid_argument("FastTwiddles: the number of twiddles must be at most the FFT size");
+}
+
+template<typename T, int Degree>
+void FastTwiddles<T, Degree>::CalculateTable()
+{
+    const std::size_t size = m_length + 1;
+    m_cos.resize(size);
+    m_sin.resize(size);
+    const FastSinCos<T, Degree> sinCos;
+    // The angles 2*Pi*j/N are at most Pi, so in half turns they are 2*j/N.
+    if constexpr (!std::is_same<T, float>::value)
+    {
+        std::vector<T> halfTurns(size);
+        for (std::size_t j = 0; j < size; ++j)
+            halfTurns[j] = static_cast<T>(2 * j) / static_cast<T>(m_n);
+        sinCos.SinCosPi(halfTurns.data(), m_sin.data(), m_cos.data(), size);
+    }
+    else
+    {
+        // j = anchor + step: cos and sin of the sum from the anchor and step values.
+        const std::size_t anchors = (size + FLOAT_STEPS - 1) / FLOAT_STEPS;
+        std::vector<T> halfTurns(anchors > FLOAT_STEPS ? anchors : FLOAT_STEPS);
+        std::vector<T> anchorSin(anchors), anchorCos(anchors), stepSin(FLOAT_STEPS), stepCos(FLOAT_STEPS);
+        for (std::size_t a = 0; a < anchors; ++a)
+            halfTurns[a] = static_cast<T>(2 * a * FLOAT_STEPS) / static_cast<T>(m_n);
+        sinCos.SinCosPi(halfTurns.data(), anchorSin.data(), anchorCos.data(), anchors);
+        for (std::size_t j = 0; j < FLOAT_STEPS; ++j)
+            halfTurns[j] = static_cast<T>(2 * j) / static_cast<T>(m_n);
+        sinCos.SinCosPi(halfTurns.data(), stepSin.data(), stepCos.data(), FLOAT_STEPS);
+        for (std::size_t a = 0; a < anchors; ++a)
+        {
+            const std::size_t first = a * FLOAT_STEPS;
+            const std::size_t steps = size - first < FLOAT_STEPS ? size - first : FLOAT_STEPS;
+            const T c = anchorCos[a], s = anchorSin[a];
+            T* const cosOut = m_cos.data() + first;
+            T* const sinOut = m_sin.data() + first;
+            for (std::size_t j = 0; j < steps; ++j)
+            {
+                cosOut[j] = c * stepCos[j] - s * stepSin[j];
+                sinOut[j] = s * stepCos[j] + c * stepSin[j];
+            }
+        }
+    }
+}
+
+#endif // __FAST_TWIDDLE__
@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// This file uses the MiniMax polynomial approximations of fast_sin.h.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastWindow added.
+// 17/10/26: FastWindow::operator() for fractional positions added.
+// 17/10/26: Generate() and Apply() calculate the window in batch loops, n == 0 is rejected.
+//
+
+#ifndef __FAST_WINDOW__
+#define __FAST_WINDOW__
+
+#include "fast_sin.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+enum class FastWindowType
+{
+    Hann,
+    Hamming,
+    Blackman,
+    BlackmanHarris, // 4-term, -92 dB side lobes
+    Kaiser
+};
+
+// FastWindow: A class to generate window functions for spectral analysis (STFT frames etc.).
+// T: The type of the calculations/window values (double/float)
+// Degree: the degree of the FastSin polynomial approximation (see fast_sin.h).
+//   The cosine-sum windows w[i] = a0 - a1*cos(t) + a2*cos(2t) - a3*cos(3t), t = 2*Pi*i/L,
+// need only one FastSinCos::CosPi() per value: the higher harmonics come from the
+// Chebyshev identities cos(2t) = 2c^2 - 1 and cos(3t) = 4c^3 - 3c. The Kaiser window uses
+// a truncated power series of the Bessel function I0, which is accurate for beta <= 20.
+//   The windows are symmetric (w[i] = w[L - i]), so only the first half is calculated.
+//   periodic = true gives the DFT-even window (L = n) used with STFT/FFT,
+// periodic = false the symmetric window (L = n - 1) used in filter design.
+//   Apply() multiplies a frame with the window without storing the window, so windowing
+// is one pass over the frame. The window values are calculated in blocks of BLOCK_SIZE with
+// the window type checked once per block, so the loops have no branches and can be vectorized
+// (see FastSinCos for the compiler options).
+//
+// Usage example:
+// FastWindow<float> hann(FastWindowType::Hann, 1024);
+// hann.Apply(frame, frame); // in place
+// FastWindow<double, 9> kaiser(FastWindowType::Kaiser, 255, false, 8.6);
+// kaiser.Generate(taps);
+//
+template<typename T = double, int Degree = 7>
+class FastWindow
+{
+public:
+    // type: the window function
+    // n: window length, at least 1 (0 throws std::invalid_argument)
+    // periodic: true = DFT-even window (period n), false = symmetric window (period n - 1)
+    // kaiserBeta: the shape parameter of the Kaiser window (not used for other types)
+    FastWindow(FastWindowType type, std::size_t n, bool periodic = true, T kaiserBeta = static_cast<T>(8.6));
+
+    // out: returns the @n window values
+    void Generate(T* out) const;
+
+    // frame: @n input samples
+    // out: returns frame[i] * w[i]. Can be the same as @frame.
+    void Apply(const T* frame, T* out) const;
+
+    // position: sample position in [0, L], can be fractional (L = n or n - 1, see @periodic)
+    // returns: the window value at @position. Used for fractional delays, e.g. polyphase filters.
+    T operator()(T position) const;
+
+private:
+    // first, count: the indexes first..first+count-1, in 0..L/2
+    // out: returns the window values w[i] of the indexes
+    void Values(std::size_t first, std::size_t count, T* out) const;
+
+    // x: argument of I0
+    // returns: modified Bessel function of the first kind I0(x), truncated series
+    static T BesselI0(T x);
+
+    inline const static int BESSEL_I0_TERMS{ 32 };
+    inline const static std::size_t BLOCK_SIZE{ 64 };
+
+    FastWindowType m_type;
+    std::size_t m_n;
+    // L: the period of the cosines, n or n - 1
+    std::size_t m_period;
+    // The cosine-sum written as a polynomial of c = cos(t): p0 + c*(p1 + c*(p2 + c*p3))
+    T m_poly[4]{};
+    T m_kaiserBeta;
+    T m_kaiserScale{};
+};
+
+template<typename T, int Degree>
+FastWindow<T, Degree>::FastWindow(const FastWindowType type, const std::size_t n, const bool periodic,
+    const T kaiserBeta) :
+    m_type{ type },
+    m_n{ n },
+    m_period{ periodic ? n : n - 1 },
+    m_kaiserBeta{ kaiserBeta }
+{
+    if (n == 0)
+        throw std::invalid_argument("FastWindow: the window length must be at least 1");
+    double a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+    switch (type)
+    {
+    case FastWindowType::Hann: a0 = 0.5; a1 = 0.5; break;
+    case FastWindowType::Hamming: a0 = 0.54; a1 = 0.46; break;
+    case FastWindowType::Blackman: a0 = 0.42; a1 = 0.5; a2 = 0.08; break;
+    case FastWindowType::BlackmanHarris: a0 = 0.35875; a1 = 0.48829; a2 = 0.14128; a3 = 0.01168; break;
+    case FastWindowType::Kaiser: m_kaiserScale = static_cast<T>(1.0) / BesselI0(kaiserBeta); break;
+    }
+    m_poly[0] = static_cast<T>(a0 - a2);
+    m_poly[1] = static_cast<T>(3.0 * a3 - a1);
+    m_poly[2] = static_cast<T>(2.0 * a2);
+    m_poly[3] = static_cast<T>(-4.0 * a3);
+}
+
+template<typename T, int Degree>
+void FastWindow<T, Degree>::Generate(T* const out) const
+{
+    if (m_n == 1)
+    {
+        out[0] = static_cast<T>(1.0);
+        return;
+    }
+    // Calculate the first half, then mirror it.
+    const std::size_t half = m_period / 2;
+    Values(0, half + 1, out);
+    for (std::size_t i = half + 1; i < m_n; ++i)
+        out[i] = out[m_period - i];
+}
+
+template<typename T, int Degree>
+void FastWindow<T, Degree>::Apply(const T* const frame, T* const out) const
+{
+    if (m_n == 1)
+    {
+        out[0] = frame[0];
+        return;
+    }
+    // Every window value is used for both i and L - i. The periodic window has one extra
+    // value w[0] without a pair, and an even L has the middle value w[L/2] without a pair.
+    T window[BLOCK_SIZE];
+    const std::size_t pairsBegin = m_period == m_n ? 1 : 0;
+    if (pairsBegin == 1)
+    {
+        Values(0, 1, window);
+        out[0] = frame[0] * window[0];
+    }
+    const std::size_t pairsEnd = (m_period + 1) / 2;
+    for (std::size_t start = pairsBegin; start < pairsEnd; start += BLOCK_SIZE)
+    {
+        const std::size_t size = pairsEnd - start < BLOCK_SIZE ? pairsEnd - start : BLOCK_SIZE;
+        Values(start, size, window);
+        for (std::size_t b = 0; b < size; ++b)
+        {
+            const std::size_t i = start + b;
+            const std::size_t j = m_period - i;
+            const T first = frame[i];
+            const T second = frame[j];
+            out[i] = first * window[b];
+            out[j] = second * window[b];
+        }
+    }
+    if (m_period % 2 == 0)
+    {
+        Values(m_period / 2, 1, window);
+        out[m_period / 2] = frame[m_period / 2] * window[0];
+    }
+}
+
+template<typename T, int Degree>
+void FastWindow<T, Degree>::Values(const std::size_t first, const std::size_t count, T* const out) const
+{
+    // In half turns the angle 2*Pi*i/L is 2*i/L.
+    const T period = static_cast<T>(m_period);
+    if (m_type == FastWindowType::Kaiser)
+    {
+        // The series of BesselI0() is summed for a block at a time, term by term, so that the
+        // inner loops run over the block and vectorize.
+        const T beta = m_kaiserBeta, scale = m_kaiserScale;
+        T q[BLOCK_SIZE], term[BLOCK_SIZE];
+        for (std::size_t start = 0; start < count; start += BLOCK_SIZE)
+        {
+            const std::size_t size = count - start < BLOCK_SIZE ? count - start : BLOCK_SIZE;
+            T* const block = out + start;
+            for (std::size_t b = 0; b < size; ++b)
+            {
+                const T r = static_cast<T>(2.0) * static_cast<T>(first + start + b) / period - static_cast<T>(1.0);
+                // A select rather than std::fmax(), which GCC does not vectorize here.
+                const T rest = static_cast<T>(1.0) - r * r;
+                const T inside = rest > static_cast<T>(0.0) ? rest : static_cast<T>(0.0);
+                const T x = beta * std::sqrt(inside);
+                q[b] = x * x * static_cast<T>(0.25);
+                term[b] = static_cast<T>(1.0);
+                block[b] = static_cast<T>(1.0);
+            }
+            for (int k = 1; k <= BESSEL_I0_TERMS; ++k)
+            {
+                const T kk = static_cast<T>(k * k);
+                for (std::size_t b = 0; b < size; ++b)
+                {
+                    term[b] *= q[b] / kk;
+                    block[b] += term[b];
+                }
+            }
+            for (std::size_t b = 0; b < size; ++b)
+                block[b] *= scale;
+        }
+        return;
+    }
+    const FastSinCos<T, Degree> sinCos;
+    const T p0 = m_poly[0], p1 = m_poly[1], p2 = m_poly[2], p3 = m_poly[3];
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        const T c = sinCos.CosPi(static_cast<T>(2.0) * static_cast<T>(first + k) / period);
+        out[k] = p0 + c * (p1 + c * (p2 + c * p3));
+    }
+}
+
+template<typename T, int Degree>
+T FastWindow<T, Degree>::operator()(const T position) const
+{
+    // In half turns the angle 2*Pi*position/L is 2*position/L.
+    const T x = static_cast<T>(2.0) * position / static_cast<T>(m_period);
+    if (m_type == FastWindowType::Kaiser)
+    {
+        const T r = x - static_cast<T>(1.0);
+        const T inside = std::fmax(static_cast<T>(1.0) - r * r, static_cast<T>(0.0));
+        return BesselI0(m_kaiserBeta * std::sqrt(inside)) * m_kaiserScale;
+    }
+    const T c = FastSinCos<T, Degree>().CosPi(x);
+    return m_poly[0] + c * (m_poly[1] + c * (m_poly[2] + c * m_poly[3]));
+}
+
+template<typename T, int Degree>
+T FastWindow<T, Degree>::BesselI0(const T x)
+{
+    // I0(x) = sum over k of ((x/2)^k / k!)^2. The number of terms is fixed so that there
+    // are no branches; 32 terms are enough for x <= 20.
+    const T q = x * x * static_cast<T>(0.25);
+    T term = static_cast<T>(1.0);
+    T sum = static_cast<T>(1.0);
+    for (int k = 1; k <= BESSEL_I0_TERMS; ++k)
+    {
+        term *= q / static_cast<T>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+#endif // __FAST_WINDOW__
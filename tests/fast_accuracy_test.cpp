@@ -0,0 +1,572 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. The accuracy test added.
+//
+
+// The accuracy test: measures the maximum errors of the fast functions against the long double
+// functions of <cmath> and compares them with the maximum errors published in the headers:
+//   FastSin (the polynomials), FastAsin, FastAtan/FastAtan2, FastTan, FastExp and FastLog for
+// every Degree, FastGeodesy (the distance and the bearing) and FastMapProjection (Web Mercator,
+// Equirectangular and UTM, the inverses and the round trips).
+// Each line prints the measured error and the published one. The published values are upper
+// bounds (rounded up), so a measured error above one is a regression: it is marked and the
+// exit code is 1. After a change of the polynomials the printed values are the new
+// tables for the headers. The samples are the same every run (fixed seeds and grids).
+//   long double must be wider than double (x86 80-bit or quad), otherwise the reference is not
+// accurate enough for the double Degrees.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_accuracy_test.cpp -o fast_accuracy_test
+// ./fast_accuracy_test
+//
+
+#include "fast_asin.h"
+#include "fast_atan.h"
+#include "fast_exp_log.h"
+#include "fast_geodesy.h"
+#include "fast_map_projection.h"
+#include "fast_sin.h"
+#include "fast_tan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const Real PI{ 3.141592653589793238462643383279502884L };
+    const Real RADIANS_PER_DEGREE{ PI / 180 };
+
+    int g_regressions{ 0 };
+
+    // name: the function and its template arguments
+    // what: the kind of the error
+    // measured, published: the maximum errors
+    // Prints one line of the table and counts the regressions.
+    void Report(const char* name, const char* what, const double measured, const double published)
+    {
+        const bool isRegression = !(measured <= published);
+        g_regressions += isRegression ? 1 : 0;
+        std::printf("%-32s %-37s %.5e  (published %.5e)%s\n", name, what, measured, published,
+            isRegression ? "  REGRESSION" : "");
+    }
+
+    // returns: |value - reference| / |reference|, 0 for a zero reference (then the value is exact
+    // in all the tested functions)
+    double RelativeError(const Real value, const Real reference)
+    {
+        return reference == 0 ? static_cast<double>(std::abs(value)) :
+            static_cast<double>(std::abs((value - reference) / reference));
+    }
+
+    // FastSin::Polynomial on a grid over [-Pi/2, Pi/2], absolute error.
+    template<int Degree>
+    void TestSin(const char* name, const double published)
+    {
+        const long points = 4000000;
+        double maxError = 0.0;
+        for (long i = -points; i <= points; ++i)
+        {
+            const double x = static_cast<double>(PI / 2 * i / points);
+            const Real reference = std::sin(static_cast<Real>(x));
+            const Real value = FastSin<double, Degree>::Polynomial(x);
+            maxError = std::max(maxError, static_cast<double>(std::abs(value - reference)));
+        }
+        Report(name, "max error", maxError, published);
+    }
+
+    // FastAsin on a grid over [-1, 1], relative error.
+    template<int Degree>
+    void TestAsin(const char* name, const double published)
+    {
+        const FastAsin<double, Degree> fastAsin;
+        const long points = 4000000;
+        double maxError = 0.0;
+        for (long i = -points; i <= points; ++i)
+        {
+            const double x = static_cast<double>(static_cast<Real>(i) / points);
+            maxError = std::max(maxError, RelativeError(fastAsin(x), std::asin(static_cast<Real>(x))));
+        }
+        Report(name, "max relative error", maxError, published);
+    }
+
+    // FastAtan on random values from 1e-8 to 1e8 (both signs) and a grid over [0, 3], FastAtan2
+    // on random points in the square [-1, 1]^2 (a third of them near the x axis), absolute error.
+    template<int Degree>
+    void TestAtan(const char* name, const double published)
+    {
+        const FastAtan<double, Degree> fastAtan;
+        const FastAtan2<double, Degree> fastAtan2;
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> exponent(-8.0, 8.0), unit(-1.0, 1.0);
+        double maxError = 0.0, maxError2 = 0.0;
+        for (int i = 0; i < 3000000; ++i)
+        {
+            const double x = unit(generator) * std::pow(10.0, exponent(generator));
+            maxError = std::max(maxError, static_cast<double>(std::abs(fastAtan(x) - std::atan(static_cast<Real>(x)))));
+            const double y = unit(generator) * (i % 3 == 0 ? 1e-6 : 1.0);
+            const double x2 = unit(generator);
+            maxError2 = std::max(maxError2, static_cast<double>(std::abs(fastAtan2(y, x2) -
+                std::atan2(static_cast<Real>(y), static_cast<Real>(x2)))));
+        }
+        for (int i = 0; i <= 3000000; ++i)
+        {
+            const double x = i * 1e-6;
+            maxError = std::max(maxError, static_cast<double>(std::abs(fastAtan(x) - std::atan(static_cast<Real>(x)))));
+        }
+        Report(name, "max error (atan, atan2)", std::max(maxError, maxError2), published);
+    }
+
+    // FastTan on random angles in [-20, 20] and on the 100 values next to each pole in it,
+    // relative error. Near the poles the rounding of the reduction adds up to POLE_ERROR.
+    template<int Degree>
+    void TestTan(const char* name, const double published)
+    {
+        const double POLE_ERROR{ 1.5e-15 };
+        const FastTan<double, Degree> fastTan;
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> angle(-20.0, 20.0);
+        double maxError = 0.0;
+        for (int i = 0; i < 4000000; ++i)
+        {
+            const double x = angle(generator);
+            maxError = std::max(maxError, RelativeError(fastTan(x), std::tan(static_cast<Real>(x))));
+        }
+        Report(name, "max relative error", maxError, published);
+        double maxPoleError = 0.0;
+        for (int k = -6; k < 6; ++k)
+        {
+            double x = static_cast<double>((k + 0.5L) * PI);
+            for (int j = 0; j < 50; ++j)
+                x = std::nextafter(x, -100.0);
+            for (int j = 0; j < 100; ++j, x = std::nextafter(x, 100.0))
+                maxPoleError = std::max(maxPoleError, RelativeError(fastTan(x), std::tan(static_cast<Real>(x))));
+        }
+        Report(name, "max relative error near poles", maxPoleError, published + POLE_ERROR);
+    }
+
+    // FastExp on random values in [-708, 708], relative error.
+    template<int Degree>
+    void TestExp(const char* name, const double published)
+    {
+        const FastExp<double, Degree> fastExp;
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> value(-708.0, 708.0);
+        double maxError = 0.0;
+        for (int i = 0; i < 4000000; ++i)
+        {
+            const double x = value(generator);
+            maxError = std::max(maxError, RelativeError(fastExp(x), std::exp(static_cast<Real>(x))));
+        }
+        Report(name, "max relative error", maxError, published);
+    }
+
+    // FastLog on random values exp(-30)..exp(30) and 1 +- 0.5: absolute error where
+    // |log(x)| >= 1 and relative error where |log(x)| < 1.
+    template<int Degree>
+    void TestLog(const char* name, const double published, const double publishedRelative)
+    {
+        const FastLog<double, Degree> fastLog;
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> value(-30.0, 30.0);
+        double maxError = 0.0, maxRelativeError = 0.0;
+        for (int i = 0; i < 4000000; ++i)
+        {
+            const double x = i % 2 == 0 ? std::exp(value(generator)) : 1.0 + value(generator) / 60.0;
+            const Real reference = std::log(static_cast<Real>(x));
+            const Real result = fastLog(x);
+            if (std::abs(reference) < 1)
+                maxRelativeError = std::max(maxRelativeError, RelativeError(result, reference));
+            else
+                maxError = std::max(maxError, static_cast<double>(std::abs(result - reference)));
+        }
+        Report(name, "max error |log| >= 1", maxError, published);
+        Report(name, "max relative error |log| < 1", maxRelativeError, publishedRelative);
+    }
+
+    // FastGeodesy::Distance and FastGeodesy::Bearing on the Earth for random point pairs and for
+    // pairs closer than 1e-4 degrees, errors in meters and degrees. The bearing is not measured
+    // within 10 degrees of the antipode, where it is ill-conditioned.
+    template<typename T, int Degree>
+    void TestGeodesy(const char* name, const double published, const double publishedBearing)
+    {
+        const std::size_t count = 300000;
+        const Real radius = 6371008.8L;
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> latitude(-90.0, 90.0), longitude(-180.0, 180.0), unit(-1.0, 1.0);
+        std::vector<T> lat1(count), lon1(count), lat2(count), lon2(count), distances(count), bearings(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            lat1[i] = static_cast<T>(latitude(generator));
+            lon1[i] = static_cast<T>(longitude(generator));
+            const bool isNear = i % 2 == 0;
+            lat2[i] = static_cast<T>(isNear ? lat1[i] + 1e-4 * unit(generator) : latitude(generator));
+            lon2[i] = static_cast<T>(isNear ? lon1[i] + 1e-4 * unit(generator) : longitude(generator));
+        }
+        const FastGeodesy<T, Degree> geodesy(static_cast<double>(radius));
+        geodesy.Distance(lat1.data(), lon1.data(), lat2.data(), lon2.data(), distances.data(), count);
+        geodesy.Bearing(lat1.data(), lon1.data(), lat2.data(), lon2.data(), bearings.data(), count);
+        double maxError = 0.0, maxBearingError = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Real phi1 = lat1[i] * RADIANS_PER_DEGREE, phi2 = lat2[i] * RADIANS_PER_DEGREE;
+            const Real sinLat = std::sin((phi2 - phi1) / 2);
+            const Real sinLon = std::sin((static_cast<Real>(lon2[i]) - lon1[i]) * RADIANS_PER_DEGREE / 2);
+            const Real h = sinLat * sinLat + std::cos(phi1) * std::cos(phi2) * sinLon * sinLon;
+            const Real reference = 2 * radius * std::asin(std::min(static_cast<Real>(1), std::sqrt(h)));
+            maxError = std::max(maxError, static_cast<double>(std::abs(distances[i] - reference)));
+            // The bearing in the form without cancellation, as in FastGeodesy, and its error modulo 360.
+            const Real cosFiveDegrees = std::cos(5 * RADIANS_PER_DEGREE);
+            const bool isNearAntipode = h > cosFiveDegrees * cosFiveDegrees;
+            const Real cosLon = std::cos((static_cast<Real>(lon2[i]) - lon1[i]) * RADIANS_PER_DEGREE / 2);
+            const Real east = 2 * sinLon * cosLon * std::cos(phi2);
+            const Real north = std::sin((static_cast<Real>(lat2[i]) - lat1[i]) * RADIANS_PER_DEGREE) +
+                2 * std::sin(phi1) * std::cos(phi2) * sinLon * sinLon;
+            const Real difference = std::abs(bearings[i] - std::atan2(east, north) / RADIANS_PER_DEGREE);
+            const Real bearingError = std::fmod(difference, static_cast<Real>(360));
+            const Real wrappedError = std::min(bearingError, 360 - bearingError);
+            maxBearingError = std::max(maxBearingError, isNearAntipode ? 0.0 : static_cast<double>(wrappedError));
+        }
+        Report(name, "max distance error (m)", maxError, published);
+        Report(name, "max bearing error (degrees)", maxBearingError, publishedBearing);
+    }
+
+    // The UTM reference: the 4th order Krueger series in long double (Karney 2011).
+    class UtmReference
+    {
+    public:
+        UtmReference()
+        {
+            const Real f = 1 / 298.257223563L;
+            const Real n = f / (2 - f), n2 = n * n, n3 = n2 * n, n4 = n3 * n;
+            m_n = n;
+            m_a = 0.9996L * 6378137 / (1 + n) * (1 + n2 / 4 + n4 / 64);
+            m_alpha[0] = n / 2 - 2 * n2 / 3 + 5 * n3 / 16 + 41 * n4 / 180;
+            m_alpha[1] = 13 * n2 / 48 - 3 * n3 / 5 + 557 * n4 / 1440;
+            m_alpha[2] = 61 * n3 / 240 - 103 * n4 / 140;
+            m_alpha[3] = 49561 * n4 / 161280;
+            m_beta[0] = n / 2 - 2 * n2 / 3 + 37 * n3 / 96 - n4 / 360;
+            m_beta[1] = n2 / 48 + n3 / 15 - 437 * n4 / 1440;
+            m_beta[2] = 17 * n3 / 480 - 37 * n4 / 840;
+            m_beta[3] = 4397 * n4 / 161280;
+        }
+
+        // lat: latitude in degrees, lon: longitude from the central meridian in degrees
+        // easting, northing: returns the UTM coordinates (northern hemisphere) in meters
+        void operator()(const Real lat, const Real lon, Real& easting, Real& northing) const
+        {
+            const Real e = 2 * std::sqrt(m_n) / (1 + m_n);
+            const Real phi = lat * RADIANS_PER_DEGREE, lambda = lon * RADIANS_PER_DEGREE;
+            const Real t = std::sinh(std::atanh(std::sin(phi)) - e * std::atanh(e * std::sin(phi)));
+            const Real xi = std::atan2(t, std::cos(lambda));
+            const Real eta = std::atanh(std::sin(lambda) / std::sqrt(1 + t * t));
+            Real x = xi, y = eta;
+            for (int j = 1; j <= 4; ++j)
+            {
+                x += m_alpha[j - 1] * std::sin(2 * j * xi) * std::cosh(2 * j * eta);
+                y += m_alpha[j - 1] * std::cos(2 * j * xi) * std::sinh(2 * j * eta);
+            }
+            easting = 500000 + m_a * y;
+            northing = m_a * x;
+        }
+
+        // easting, northing: UTM coordinates (northern hemisphere) in meters
+        // lat, lon: returns the latitude and the longitude from the central meridian in degrees
+        void Inverse(const Real easting, const Real northing, Real& lat, Real& lon) const
+        {
+            const Real e = 2 * std::sqrt(m_n) / (1 + m_n);
+            const Real xi = northing / m_a, eta = (easting - 500000) / m_a;
+            Real x = xi, y = eta;
+            for (int j = 1; j <= 4; ++j)
+            {
+                x -= m_beta[j - 1] * std::sin(2 * j * xi) * std::cosh(2 * j * eta);
+                y -= m_beta[j - 1] * std::cos(2 * j * xi) * std::sinh(2 * j * eta);
+            }
+            // The conformal latitude chi, then the geodetic latitude from
+            // atanh(sin(phi)) - e * atanh(e * sin(phi)) = asinh(tan(chi)) with Newton's method.
+            const Real chi = std::asin(std::sin(x) / std::cosh(y));
+            const Real target = std::asinh(std::tan(chi));
+            const Real e2 = e * e;
+            Real phi = chi;
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                const Real sinPhi = std::sin(phi);
+                const Real value = std::atanh(sinPhi) - e * std::atanh(e * sinPhi) - target;
+                phi -= value * std::cos(phi) * (1 - e2 * sinPhi * sinPhi) / (1 - e2);
+            }
+            lat = phi / RADIANS_PER_DEGREE;
+            lon = std::atan2(std::sinh(y), std::cos(x)) / RADIANS_PER_DEGREE;
+        }
+
+    private:
+        Real m_n;
+        Real m_a;
+        Real m_alpha[4];
+        Real m_beta[4];
+    };
+
+    // returns: the largest distance between the points (@lat, @lon) and (@referenceLat, @referenceLon)
+    // (degrees) on the ground in meters, the larger of the north and east parts on the WGS84 equator
+    // sphere
+    template<typename T, typename U>
+    double MaxGroundError(const std::vector<T>& lat, const std::vector<T>& lon, const std::vector<U>& referenceLat,
+        const std::vector<U>& referenceLon)
+    {
+        const Real metersPerDegree = 6378137.0L * RADIANS_PER_DEGREE;
+        double maxError = 0.0;
+        for (std::size_t i = 0; i < lat.size(); ++i)
+        {
+            const Real north = std::abs(lat[i] - static_cast<Real>(referenceLat[i]));
+            const Real east = std::abs(lon[i] - static_cast<Real>(referenceLon[i])) *
+                std::cos(referenceLat[i] * RADIANS_PER_DEGREE);
+            maxError = std::max(maxError, static_cast<double>(metersPerDegree * std::max(north, east)));
+        }
+        return maxError;
+    }
+
+    // FastMapProjection::WebMercator up to 85 degrees and FastMapProjection::Utm (zone 31) within
+    // 3.5 degrees of the central meridian, error in meters.
+    template<typename T, int Degree>
+    void TestMapProjection(const char* name, const double publishedWebMercator, const double publishedUtm)
+    {
+        const int count = 200000;
+        const Real radius = 6378137.0L;
+        const FastMapProjection<T, Degree> projection;
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> mercatorLatitude(-85.05, 85.05), longitude(-180.0, 180.0),
+            utmLatitude(-80.0, 84.0), utmLongitude(-3.5, 3.5);
+        std::vector<T> lat(count), lon(count), x(count), y(count);
+        for (int i = 0; i < count; ++i)
+        {
+            lat[i] = static_cast<T>(mercatorLatitude(generator));
+            lon[i] = static_cast<T>(longitude(generator));
+        }
+        projection.WebMercator(lat.data(), lon.data(), x.data(), y.data(), count);
+        double maxError = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            const Real referenceX = radius * lon[i] * RADIANS_PER_DEGREE;
+            const Real referenceY = radius * std::atanh(std::sin(lat[i] * RADIANS_PER_DEGREE));
+            maxError = std::max(maxError, static_cast<double>(std::max(std::abs(x[i] - referenceX),
+                std::abs(y[i] - referenceY))));
+        }
+        Report(name, "max Web Mercator error (m)", maxError, publishedWebMercator);
+
+        const UtmReference utm;
+        for (int i = 0; i < count; ++i)
+        {
+            lat[i] = static_cast<T>(utmLatitude(generator));
+            lon[i] = static_cast<T>(utmLongitude(generator) + 3.0);
+        }
+        projection.Utm(lat.data(), lon.data(), x.data(), y.data(), count, 31);
+        maxError = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            Real easting, northing;
+            utm(lat[i], static_cast<Real>(lon[i]) - 3, easting, northing);
+            maxError = std::max(maxError, static_cast<double>(std::max(std::abs(x[i] - easting),
+                std::abs(y[i] - northing))));
+        }
+        Report(name, "max UTM error (m)", maxError, publishedUtm);
+    }
+
+    // FastMapProjection::Equirectangular (standard parallel 40 degrees, central meridian 10
+    // degrees) on the whole sphere, error in meters, and the inverse projections on the points of
+    // TestMapProjection: the inverse of the long double projection (rounded to T) against the long
+    // double inverse, and the round trip (the fast projection and the fast inverse) against the
+    // input, errors on the ground in meters.
+    template<typename T, int Degree>
+    void TestInverseMapProjection(const char* name, const double publishedInverseWebMercator,
+        const double publishedWebMercatorRoundTrip, const double publishedEquirectangular,
+        const double publishedInverseEquirectangular, const double publishedEquirectangularRoundTrip,
+        const double publishedInverseUtm, const double publishedUtmRoundTrip)
+    {
+        const int count = 200000;
+        const Real radius = 6378137.0L;
+        const double standardParallel = 40.0, centralMeridian = 10.0;
+        const Real scaleX = radius * RADIANS_PER_DEGREE * std::cos(standardParallel * RADIANS_PER_DEGREE);
+        const Real scaleY = radius * RADIANS_PER_DEGREE;
+        const FastMapProjection<T, Degree> projection;
+        std::mt19937_64 generator(2);
+        std::uniform_real_distribution<double> mercatorLatitude(-85.05, 85.05), longitude(-180.0, 180.0),
+            latitude(-90.0, 90.0), utmLatitude(-80.0, 84.0), utmLongitude(-3.5, 3.5);
+        std::vector<T> lat(count), lon(count), x(count), y(count), inverseLat(count), inverseLon(count);
+        std::vector<Real> referenceLat(count), referenceLon(count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            lat[i] = static_cast<T>(mercatorLatitude(generator));
+            lon[i] = static_cast<T>(longitude(generator));
+            x[i] = static_cast<T>(radius * lon[i] * RADIANS_PER_DEGREE);
+            y[i] = static_cast<T>(radius * std::atanh(std::sin(lat[i] * RADIANS_PER_DEGREE)));
+            referenceLat[i] = std::atan(std::sinh(y[i] / radius)) / RADIANS_PER_DEGREE;
+            referenceLon[i] = x[i] / radius / RADIANS_PER_DEGREE;
+        }
+        projection.InverseWebMercator(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count);
+        Report(name, "max inverse Web Mercator error (m)", MaxGroundError(inverseLat, inverseLon, referenceLat,
+            referenceLon), publishedInverseWebMercator);
+        projection.WebMercator(lat.data(), lon.data(), x.data(), y.data(), count);
+        projection.InverseWebMercator(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count);
+        Report(name, "max Web Mercator round trip (m)", MaxGroundError(inverseLat, inverseLon, lat, lon),
+            publishedWebMercatorRoundTrip);
+
+        for (int i = 0; i < count; ++i)
+        {
+            lat[i] = static_cast<T>(latitude(generator));
+            lon[i] = static_cast<T>(longitude(generator));
+        }
+        projection.Equirectangular(lat.data(), lon.data(), x.data(), y.data(), count, standardParallel,
+            centralMeridian);
+        double maxError = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            const Real referenceX = scaleX * (lon[i] - static_cast<Real>(centralMeridian));
+            const Real referenceY = scaleY * lat[i];
+            maxError = std::max(maxError, static_cast<double>(std::max(std::abs(x[i] - referenceX),
+                std::abs(y[i] - referenceY))));
+            x[i] = static_cast<T>(referenceX);
+            y[i] = static_cast<T>(referenceY);
+            referenceLat[i] = y[i] / scaleY;
+            referenceLon[i] = centralMeridian + x[i] / scaleX;
+        }
+        Report(name, "max Equirectangular error (m)", maxError, publishedEquirectangular);
+        projection.InverseEquirectangular(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count,
+            standardParallel, centralMeridian);
+        Report(name, "max inverse Equirectangular error (m)", MaxGroundError(inverseLat, inverseLon, referenceLat,
+            referenceLon), publishedInverseEquirectangular);
+        projection.Equirectangular(lat.data(), lon.data(), x.data(), y.data(), count, standardParallel,
+            centralMeridian);
+        projection.InverseEquirectangular(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count,
+            standardParallel, centralMeridian);
+        Report(name, "max Equirectangular round trip (m)", MaxGroundError(inverseLat, inverseLon, lat, lon),
+            publishedEquirectangularRoundTrip);
+
+        const UtmReference utm;
+        for (int i = 0; i < count; ++i)
+        {
+            lat[i] = static_cast<T>(utmLatitude(generator));
+            lon[i] = static_cast<T>(utmLongitude(generator) + 3.0);
+            Real easting, northing;
+            utm(lat[i], static_cast<Real>(lon[i]) - 3, easting, northing);
+            x[i] = static_cast<T>(easting);
+            y[i] = static_cast<T>(northing);
+            utm.Inverse(x[i], y[i], referenceLat[i], referenceLon[i]);
+            referenceLon[i] += 3;
+        }
+        projection.InverseUtm(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count, 31);
+        Report(name, "max inverse UTM error (m)", MaxGroundError(inverseLat, inverseLon, referenceLat,
+            referenceLon), publishedInverseUtm);
+        projection.Utm(lat.data(), lon.data(), x.data(), y.data(), count, 31);
+        projection.InverseUtm(x.data(), y.data(), inverseLat.data(), inverseLon.data(), count, 31);
+        Report(name, "max UTM round trip (m)", MaxGroundError(inverseLat, inverseLon, lat, lon),
+            publishedUtmRoundTrip);
+    }
+}
+
+int main()
+{
+    if (std::numeric_limits<Real>::digits <= std::numeric_limits<double>::digits)
+        std::printf("WARNING: long double is not wider than double, the double results are not reliable\n");
+
+    TestSin<7>("FastSin<double, 7>::Polynomial", 9.39102e-07);
+    TestSin<9>("FastSin<double, 9>::Polynomial", 5.31400e-09);
+    TestSin<11>("FastSin<double, 11>::Polynomial", 2.11510e-11);
+    TestSin<13>("FastSin<double, 13>::Polynomial", 6.26804e-14);
+    TestSin<15>("FastSin<double, 15>::Polynomial", 4.19641e-16);
+
+    TestAsin<5>("FastAsin<double, 5>", 7.53317e-05);
+    TestAsin<7>("FastAsin<double, 7>", 3.48035e-06);
+    TestAsin<9>("FastAsin<double, 9>", 1.77962e-07);
+    TestAsin<11>("FastAsin<double, 11>", 9.69305e-09);
+    TestAsin<15>("FastAsin<double, 15>", 3.23540e-11);
+    TestAsin<19>("FastAsin<double, 19>", 1.19285e-13);
+    TestAsin<23>("FastAsin<double, 23>", 8.91435e-16);
+
+    TestAtan<5>("FastAtan<double, 5>", 8.81023e-06);
+    TestAtan<7>("FastAtan<double, 7>", 2.57089e-07);
+    TestAtan<9>("FastAtan<double, 9>", 8.06416e-09);
+    TestAtan<11>("FastAtan<double, 11>", 2.64391e-10);
+    TestAtan<13>("FastAtan<double, 13>", 8.93192e-12);
+    TestAtan<15>("FastAtan<double, 15>", 3.08426e-13);
+    TestAtan<17>("FastAtan<double, 17>", 1.10656e-14);
+    TestAtan<19>("FastAtan<double, 19>", 7.95371e-16);
+
+    TestTan<5>("FastTan<double, 5>", 1.28486e-05);
+    TestTan<7>("FastTan<double, 7>", 3.46005e-08);
+    TestTan<9>("FastTan<double, 9>", 5.86206e-11);
+    TestTan<11>("FastTan<double, 11>", 6.83975e-14);
+    TestTan<13>("FastTan<double, 13>", 4.42024e-16);
+
+    TestExp<5>("FastExp<double, 5>", 1.05e-07);
+    TestExp<7>("FastExp<double, 7>", 5.18e-11);
+    TestExp<9>("FastExp<double, 9>", 1.67e-14);
+    TestExp<11>("FastExp<double, 11>", 2.21e-16);
+
+    TestLog<5>("FastLog<double, 5>", 5.06e-08, 1.46e-07);
+    TestLog<7>("FastLog<double, 7>", 2.79e-10, 8.04e-10);
+    TestLog<9>("FastLog<double, 9>", 1.66e-12, 4.77e-12);
+    TestLog<11>("FastLog<double, 11>", 1.08e-14, 2.98e-14);
+    TestLog<13>("FastLog<double, 13>", 3.81e-16, 5.09e-16);
+
+    TestGeodesy<double, 7>("FastGeodesy<double, 7>", 21.0, 1.3e-3);
+    TestGeodesy<double, 9>("FastGeodesy<double, 9>", 0.15, 5.5e-6);
+    TestGeodesy<double, 11>("FastGeodesy<double, 11>", 0.61e-3, 2.6e-8);
+    TestGeodesy<double, 13>("FastGeodesy<double, 13>", 2e-6, 6.1e-11);
+    TestGeodesy<double, 15>("FastGeodesy<double, 15>", 1.1e-8, 1.2e-12);
+    TestGeodesy<float, 9>("FastGeodesy<float, 9>", 4.3, 1.9e-4);
+
+    TestMapProjection<double, 7>("FastMapProjection<double, 7>", 9.0, 9.0);
+    TestMapProjection<double, 9>("FastMapProjection<double, 9>", 0.05, 0.073);
+    TestMapProjection<double, 11>("FastMapProjection<double, 11>", 0.2e-3, 0.2e-3);
+    TestMapProjection<double, 13>("FastMapProjection<double, 13>", 5e-6, 5e-6);
+    TestMapProjection<double, 15>("FastMapProjection<double, 15>", 5e-6, 5e-6);
+    TestMapProjection<float, 9>("FastMapProjection<float, 9>", 3.0, 3.0);
+
+    TestInverseMapProjection<double, 7>("FastMapProjection<double, 7>",
+        2.3, 7.9, 3.2e-9, 3.7e-9, 1.6e-9, 5.4, 14.0);
+    TestInverseMapProjection<double, 9>("FastMapProjection<double, 9>",
+        0.052, 0.065, 3.2e-9, 3.7e-9, 1.6e-9, 0.058, 0.14);
+    TestInverseMapProjection<double, 11>("FastMapProjection<double, 11>",
+        5.7e-5, 1.5e-4, 3.2e-9, 3.7e-9, 1.6e-9, 6.9e-5, 1.8e-4);
+    TestInverseMapProjection<double, 13>("FastMapProjection<double, 13>",
+        1.6e-7, 6.3e-7, 3.2e-9, 3.7e-9, 1.6e-9, 2.7e-6, 3.2e-6);
+    TestInverseMapProjection<double, 15>("FastMapProjection<double, 15>",
+        4.6e-9, 5.2e-9, 3.2e-9, 3.7e-9, 1.6e-9, 2.6e-6, 2.8e-6);
+    TestInverseMapProjection<float, 9>("FastMapProjection<float, 9>",
+        1.4, 2.0, 1.5, 1.8, 2.6, 2.5, 3.4);
+
+    if (g_regressions > 0)
+        std::printf("%d REGRESSION(S)\n", g_regressions);
+    else
+        std::printf("All errors are within the published maximum errors.\n");
+    return g_regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastDual test added.
+//
+
+// The FastDual test: compares the values and the derivatives of the FastSinCos dual number
+// overloads with sin, cos and their derivatives cos(x) * dx and -sin(x) * dx in long double,
+// for one and three derivatives, the scalar and the batch versions (with counts that are not
+// a multiple of the block size), Sin() and Cos(), and the output in the same object as the
+// input. The derivatives are also checked against central differences of the long double
+// functions, so the sign convention is checked independently of the formulas (at the accuracy
+// of the difference quotient).
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_dual_test.cpp -o fast_dual_test
+// ./fast_dual_test
+//
+
+#include "fast_sin.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const std::size_t COUNT{ 1001 };
+
+    // returns: the larger of the errors of @sinValue and @cosValue against sin(x) and cos(x) of
+    // the angle @angle, with the derivatives
+    template<typename T, int N>
+    double DualError(const FastDual<T, N>& angle, const FastDual<T, N>& sinValue, const FastDual<T, N>& cosValue)
+    {
+        const Real x = angle.value;
+        const Real s = std::sin(x), c = std::cos(x);
+        Real error = std::max(std::abs(sinValue.value - s), std::abs(cosValue.value - c));
+        for (int k = 0; k < N; ++k)
+        {
+            const Real dx = angle.derivatives[k];
+            error = std::max(error, std::abs(sinValue.derivatives[k] - c * dx));
+            error = std::max(error, std::abs(cosValue.derivatives[k] + s * dx));
+        }
+        return static_cast<double>(error);
+    }
+
+    template<typename T, int Degree, int N>
+    void TestDerivatives(FastTest& test, const char* type, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-100.0, 100.0);
+        std::uniform_real_distribution<double> direction(-2.0, 2.0);
+        std::vector<FastDual<T, N>> angles(COUNT), sinValues(COUNT), cosValues(COUNT);
+        for (FastDual<T, N>& angle : angles)
+        {
+            angle.value = static_cast<T>(uniform(generator));
+            for (int k = 0; k < N; ++k)
+                angle.derivatives[k] = static_cast<T>(direction(generator));
+        }
+        const FastSinCos<T, Degree> sinCos;
+        double scalarError = 0.0, functionError = 0.0, inPlaceError = 0.0, differenceError = 0.0;
+        for (const FastDual<T, N>& angle : angles)
+        {
+            FastDual<T, N> sinValue, cosValue;
+            sinCos(angle, sinValue, cosValue);
+            scalarError = std::max(scalarError, DualError(angle, sinValue, cosValue));
+            functionError = std::max(functionError, DualError(angle, sinCos.Sin(angle), sinCos.Cos(angle)));
+            // The output in the input object.
+            FastDual<T, N> inPlace = angle, otherValue;
+            sinCos(inPlace, inPlace, otherValue);
+            inPlaceError = std::max(inPlaceError, DualError(angle, inPlace, otherValue));
+            // d sin(x + h * dx) / dh at h = 0, with a central difference.
+            const Real h = 1e-5L, x = angle.value;
+            for (int k = 0; k < N; ++k)
+            {
+                const Real dx = angle.derivatives[k];
+                const Real sinDifference = (std::sin(x + h * dx) - std::sin(x - h * dx)) / (2 * h);
+                const Real cosDifference = (std::cos(x + h * dx) - std::cos(x - h * dx)) / (2 * h);
+                differenceError = std::max(differenceError, static_cast<double>(std::max(std::abs(
+                    sinValue.derivatives[k] - sinDifference), std::abs(cosValue.derivatives[k] - cosDifference))));
+            }
+        }
+        sinCos(angles.data(), sinValues.data(), cosValues.data(), COUNT);
+        double batchError = 0.0;
+        for (std::size_t n = 0; n < COUNT; ++n)
+            batchError = std::max(batchError, DualError(angles[n], sinValues[n], cosValues[n]));
+        const std::string prefix = std::string(type) + ", N = " + std::to_string(N);
+        test.Check((prefix + ": operator()").c_str(), scalarError, bound);
+        test.Check((prefix + ": Sin() and Cos()").c_str(), functionError, bound);
+        test.Check((prefix + ": output in the input object").c_str(), inPlaceError, bound);
+        test.Check((prefix + ": batch").c_str(), batchError, bound);
+        // The difference quotient has an error of h^2 * |dx|^3 / 6 (under 1.4e-10) and the rounding
+        // of x + h * dx divided by h (under 1.5e-12) on top.
+        test.Check((prefix + ": against central differences").c_str(), differenceError, bound + 1.5e-10);
+    }
+}
+
+int main()
+{
+    FastTest test("FastDual");
+    // The derivatives are the values times |dx| <= 2, so their error is up to twice the FastSin error.
+    TestDerivatives<double, 15, 1>(test, "double/15", 2e-15);
+    TestDerivatives<double, 15, 3>(test, "double/15", 2e-15);
+    TestDerivatives<float, 7, 1>(test, "float/7", 4e-6);
+    TestDerivatives<float, 7, 3>(test, "float/7", 4e-6);
+    return test.Result();
+}
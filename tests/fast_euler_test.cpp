@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastEuler test added.
+//
+
+// The FastEuler test: compares Matrices() and Quaternions() with the product of the three
+// elementary rotations of the sequence calculated in long double, for all six orders, intrinsic
+// and extrinsic. This checks the relabeling of the axes and the sign change of the odd
+// permutations (XZY, YXZ, ZYX), which only the whole product shows. A plane stride larger than
+// the count is checked too.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_euler_test.cpp -o fast_euler_test
+// ./fast_euler_test
+//
+
+#include "fast_euler.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const Real PI{ 3.141592653589793238462643383279502884L };
+    const std::size_t COUNT{ 1000 };
+    const std::size_t STRIDE{ 1024 };
+    const char* const ORDER_NAMES[6]{ "XYZ", "XZY", "YXZ", "YZX", "ZXY", "ZYX" };
+    const std::size_t ORDER_AXES[6][3]{ { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+
+    // matrix: returns the rotation of @angle about @axis (row-major)
+    void Rotation(const std::size_t axis, const Real angle, Real matrix[9])
+    {
+        const std::size_t i = (axis + 1) % 3, j = (axis + 2) % 3;
+        std::fill(matrix, matrix + 9, static_cast<Real>(0));
+        matrix[4 * axis] = 1;
+        matrix[4 * i] = std::cos(angle);
+        matrix[3 * i + j] = -std::sin(angle);
+        matrix[3 * j + i] = std::sin(angle);
+        matrix[4 * j] = std::cos(angle);
+    }
+
+    // out: returns @a * @b (3x3, row-major)
+    void Multiply(const Real a[9], const Real b[9], Real out[9])
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int column = 0; column < 3; ++column)
+            {
+                out[3 * row + column] = a[3 * row] * b[column] + a[3 * row + 1] * b[3 + column] +
+                    a[3 * row + 2] * b[6 + column];
+            }
+        }
+    }
+
+    // out: returns the Hamilton product @a * @b (w, x, y, z)
+    void QuaternionMultiply(const Real a[4], const Real b[4], Real out[4])
+    {
+        out[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+        out[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+        out[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+        out[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+    }
+
+    template<typename T, int Degree>
+    void TestType(FastTest& test, const char* type, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-PI, PI);
+        std::vector<T> angles[3];
+        for (std::vector<T>& axisAngles : angles)
+        {
+            axisAngles.resize(COUNT);
+            for (T& angle : axisAngles)
+                angle = static_cast<T>(uniform(generator));
+        }
+        for (int order = 0; order < 6; ++order)
+        {
+            for (const bool extrinsic : { false, true })
+            {
+                const FastEuler<T, Degree> euler(static_cast<FastEulerOrder>(order), extrinsic);
+                std::vector<T> matrices(9 * STRIDE), quaternions(4 * STRIDE);
+                euler.Matrices(angles[0].data(), angles[1].data(), angles[2].data(), COUNT, matrices.data(), STRIDE);
+                euler.Quaternions(angles[0].data(), angles[1].data(), angles[2].data(), COUNT, quaternions.data(),
+                    STRIDE);
+                // The intrinsic sequence: an extrinsic one is applied in the reverse order.
+                std::size_t axes[3];
+                for (int i = 0; i < 3; ++i)
+                    axes[i] = extrinsic ? ORDER_AXES[order][2 - i] : ORDER_AXES[order][i];
+                double matrixError = 0.0, quaternionError = 0.0;
+                for (std::size_t n = 0; n < COUNT; ++n)
+                {
+                    Real matrix[9]{ 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+                    Real quaternion[4]{ 1, 0, 0, 0 };
+                    for (const std::size_t axis : axes)
+                    {
+                        const Real angle = angles[axis][n];
+                        Real rotation[9], product[9];
+                        Rotation(axis, angle, rotation);
+                        Multiply(matrix, rotation, product);
+                        std::copy(product, product + 9, matrix);
+                        Real axisQuaternion[4]{ std::cos(angle / 2), 0, 0, 0 };
+                        axisQuaternion[1 + axis] = std::sin(angle / 2);
+                        Real quaternionProduct[4];
+                        QuaternionMultiply(quaternion, axisQuaternion, quaternionProduct);
+                        std::copy(quaternionProduct, quaternionProduct + 4, quaternion);
+                    }
+                    for (std::size_t e = 0; e < 9; ++e)
+                    {
+                        matrixError = std::max(matrixError,
+                            static_cast<double>(std::abs(matrices[e * STRIDE + n] - matrix[e])));
+                    }
+                    for (std::size_t e = 0; e < 4; ++e)
+                    {
+                        quaternionError = std::max(quaternionError,
+                            static_cast<double>(std::abs(quaternions[e * STRIDE + n] - quaternion[e])));
+                    }
+                }
+                const std::string prefix = std::string(type) + ", " + (extrinsic ? "extrinsic " : "intrinsic ") +
+                    ORDER_NAMES[order];
+                test.Check((prefix + ": Matrices").c_str(), matrixError, bound);
+                test.Check((prefix + ": Quaternions").c_str(), quaternionError, bound);
+            }
+        }
+    }
+}
+
+int main()
+{
+    FastTest test("FastEuler");
+    TestType<double, 15>(test, "double/15", 2e-15);
+    TestType<float, 7>(test, "float/7", 5e-6);
+    return test.Result();
+}
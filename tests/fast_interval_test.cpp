@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastSinCosInterval test added.
+//
+
+// The FastSinCosInterval test: compares the bounds with the true minimum and maximum of sin and
+// cos over the interval, calculated in long double from the values at the ends and the
+// multiples of Pi/2 inside. The bounds must contain the true ones (conservative), and must not
+// be looser than three times the padding (tight). The exception is the +-1 of an extremum just
+// outside the interval, which is counted because the range of quarter turns is widened by a few
+// ulps: that looseness is at most 1 - cos of the widening angle. The intervals are random,
+// from 1e-6 to more than a full turn long, with angles up to 10 and up to 1e5 radians, and also
+// start or end just at a multiple of Pi/2, where a missed extremum would show.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_interval_test.cpp -o fast_interval_test
+// ./fast_interval_test
+//
+
+#include "fast_interval.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const Real PI{ 3.141592653589793238462643383279502884L };
+    const std::size_t COUNT{ 100000 };
+
+    // The kinds of intervals.
+    enum class Intervals
+    {
+        Random,
+        AtQuarterTurns
+    };
+
+    // bounds: returns the true sinMin, sinMax, cosMin and cosMax over [@a, @b]
+    void TrueBounds(const Real a, const Real b, Real bounds[4])
+    {
+        bounds[0] = std::min(std::sin(a), std::sin(b));
+        bounds[1] = std::max(std::sin(a), std::sin(b));
+        bounds[2] = std::min(std::cos(a), std::cos(b));
+        bounds[3] = std::max(std::cos(a), std::cos(b));
+        // The multiples j * Pi/2 inside: sin is 1 at j = 1 (mod 4) and -1 at j = 3, cos is 1 at
+        // j = 0 and -1 at j = 2.
+        const long long first = static_cast<long long>(std::ceil(a / (PI / 2)));
+        const long long last = static_cast<long long>(std::floor(b / (PI / 2)));
+        for (long long j = first; j <= last && j < first + 4; ++j)
+        {
+            switch (((j % 4) + 4) % 4)
+            {
+            case 0: bounds[3] = 1; break;
+            case 1: bounds[1] = 1; break;
+            case 2: bounds[2] = -1; break;
+            default: bounds[0] = -1; break;
+            }
+        }
+    }
+
+    template<typename T, int Degree>
+    void TestIntervals(FastTest& test, const char* type, const Intervals intervals, const double range)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-range, range);
+        std::uniform_real_distribution<double> logWidth(-6.0, 1.0);
+        std::vector<T> a(COUNT), b(COUNT), sinMin(COUNT), sinMax(COUNT), cosMin(COUNT), cosMax(COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            // Widths from 1e-6 to 10 radians (more than a full turn).
+            const double width = std::pow(10.0, logWidth(generator));
+            if (intervals == Intervals::Random)
+            {
+                a[n] = static_cast<T>(uniform(generator));
+            }
+            else
+            {
+                // A multiple of Pi/2 rounded to T, as the start or (below) the end.
+                a[n] = static_cast<T>(std::round(uniform(generator) / (PI / 2)) * (PI / 2));
+            }
+            b[n] = static_cast<T>(a[n] + width);
+            if (intervals == Intervals::AtQuarterTurns && n % 2 == 1)
+            {
+                b[n] = a[n];
+                a[n] = static_cast<T>(b[n] - width);
+            }
+        }
+        const FastSinCosInterval<T, Degree> interval;
+        interval(a.data(), b.data(), sinMin.data(), sinMax.data(), cosMin.data(), cosMax.data(), COUNT);
+        double violation = 0.0, looseness = 0.0;
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            Real bounds[4];
+            TrueBounds(a[n], b[n], bounds);
+            const Real lower[2]{ sinMin[n], cosMin[n] };
+            const Real upper[2]{ sinMax[n], cosMax[n] };
+            const Real absA = std::abs(static_cast<Real>(a[n])), absB = std::abs(static_cast<Real>(b[n]));
+            const Real padding = static_cast<Real>(FastSinCosInterval<T, Degree>::PADDING) +
+                static_cast<Real>(FastSinCosInterval<T, Degree>::PADDING_PER_RADIAN) * std::max(absA, absB);
+            // The widening of the quarter turns as an angle, twice for margin.
+            const Real widening = 2 * 4 * std::numeric_limits<T>::epsilon() * std::max(absA, absB);
+            const Real extremumLooseness = 1 - std::cos(widening);
+            for (int f = 0; f < 2; ++f)
+            {
+                violation = std::max(violation, static_cast<double>(std::max(lower[f] - bounds[2 * f],
+                    bounds[2 * f + 1] - upper[f])));
+                // Relative to the padding of the interval.
+                looseness = std::max(looseness, static_cast<double>((std::max(bounds[2 * f] - lower[f],
+                    upper[f] - bounds[2 * f + 1]) - extremumLooseness) / padding));
+            }
+        }
+        const std::string prefix = std::string(type) + ", " +
+            (intervals == Intervals::Random ? "random" : "at multiples of Pi/2") + ", |angle| < " +
+            (range < 100.0 ? "10" : "1e5");
+        test.Check((prefix + ": true bounds outside").c_str(), violation, 0.0);
+        test.Check((prefix + ": looseness / padding").c_str(), looseness, 3.0);
+    }
+
+    template<typename T, int Degree>
+    void TestType(FastTest& test, const char* type)
+    {
+        for (const double range : { 10.0, 1e5 })
+        {
+            TestIntervals<T, Degree>(test, type, Intervals::Random, range);
+            TestIntervals<T, Degree>(test, type, Intervals::AtQuarterTurns, range);
+        }
+    }
+}
+
+int main()
+{
+    FastTest test("FastSinCosInterval");
+    TestType<double, 15>(test, "double/15");
+    TestType<double, 7>(test, "double/7");
+    TestType<float, 7>(test, "float/7");
+    return test.Result();
+}
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastKinematics test added.
+//
+
+// The FastKinematics test: compares the end-effector poses and the frames of all joints with
+// the product of the full 4 x 4 DH transforms calculated in long double, for a six-joint arm
+// in standard DH (UR5) and one in modified DH (PUMA 560, Craig), with joint offsets, 1000
+// random configurations and a plane stride larger than the count. The lengths are in meters.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_kinematics_test.cpp -o fast_kinematics_test
+// ./fast_kinematics_test
+//
+
+#include "fast_kinematics.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const double PI{ 3.141592653589793 };
+    const std::size_t JOINTS{ 6 };
+    const std::size_t COUNT{ 1000 };
+    const std::size_t STRIDE{ 1024 };
+
+    // UR5, standard DH, with offsets on two joints.
+    const FastDhJoint UR5[JOINTS]{ { 0.0, PI / 2, 0.089159, 0.0 }, { -0.425, 0.0, 0.0, 0.3 },
+        { -0.39225, 0.0, 0.0, 0.0 }, { 0.0, PI / 2, 0.10915, -1.2 }, { 0.0, -PI / 2, 0.09465, 0.0 },
+        { 0.0, 0.0, 0.0823, 0.0 } };
+    // PUMA 560, modified DH (Craig), with an offset on one joint.
+    const FastDhJoint PUMA560[JOINTS]{ { 0.0, 0.0, 0.0, 0.0 }, { 0.0, -PI / 2, 0.0, 0.0 },
+        { 0.4318, 0.0, 0.15005, -PI / 2 }, { 0.0203, -PI / 2, 0.4318, 0.0 }, { 0.0, PI / 2, 0.0, 0.0 },
+        { 0.0, -PI / 2, 0.0, 0.0 } };
+
+    // out: returns @a * @b (4 x 4, row-major)
+    void Multiply(const Real a[16], const Real b[16], Real out[16])
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                Real sum = 0;
+                for (int k = 0; k < 4; ++k)
+                    sum += a[4 * row + k] * b[4 * k + column];
+                out[4 * row + column] = sum;
+            }
+        }
+    }
+
+    // out: returns the transform of @joint with the joint variable @q
+    void JointTransform(const FastDhJoint& joint, const FastDhConvention convention, const Real q, Real out[16])
+    {
+        const Real theta = q + static_cast<Real>(joint.thetaOffset);
+        const Real c = std::cos(theta), s = std::sin(theta);
+        const Real ca = std::cos(static_cast<Real>(joint.alpha)), sa = std::sin(static_cast<Real>(joint.alpha));
+        const Real a = joint.a, d = joint.d;
+        const Real rotZ[16]{ c, -s, 0, 0, s, c, 0, 0, 0, 0, 1, d, 0, 0, 0, 1 }; // Rz(theta) * Tz(d)
+        const Real rotX[16]{ 1, 0, 0, a, 0, ca, -sa, 0, 0, sa, ca, 0, 0, 0, 0, 1 }; // Tx(a) * Rx(alpha)
+        if (convention == FastDhConvention::Standard)
+        {
+            Multiply(rotZ, rotX, out);
+        }
+        else
+        {
+            // Rx(alpha) * Tx(a) is Tx(a) * Rx(alpha): the translation is along the rotation axis.
+            Multiply(rotX, rotZ, out);
+        }
+    }
+
+    template<typename T, int Degree>
+    void TestArm(FastTest& test, const char* type, const char* arm, const FastDhJoint* joints,
+        const FastDhConvention convention, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-PI, PI);
+        std::vector<T> angles(JOINTS * STRIDE);
+        for (std::size_t j = 0; j < JOINTS; ++j)
+        {
+            for (std::size_t n = 0; n < COUNT; ++n)
+                angles[j * STRIDE + n] = static_cast<T>(uniform(generator));
+        }
+        const FastKinematics<JOINTS, T, Degree> kinematics(joints, convention);
+        std::vector<T> poses(12 * STRIDE), frames(12 * JOINTS * STRIDE);
+        kinematics(angles.data(), poses.data(), COUNT, STRIDE);
+        kinematics.Frames(angles.data(), frames.data(), COUNT, STRIDE);
+        double poseError = 0.0, frameError = 0.0;
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            Real pose[16]{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+            for (std::size_t j = 0; j < JOINTS; ++j)
+            {
+                Real transform[16], product[16];
+                JointTransform(joints[j], convention, angles[j * STRIDE + n], transform);
+                Multiply(pose, transform, product);
+                std::copy(product, product + 16, pose);
+                for (std::size_t e = 0; e < 12; ++e)
+                {
+                    frameError = std::max(frameError,
+                        static_cast<double>(std::abs(frames[(12 * j + e) * STRIDE + n] - pose[e])));
+                }
+            }
+            for (std::size_t e = 0; e < 12; ++e)
+                poseError = std::max(poseError, static_cast<double>(std::abs(poses[e * STRIDE + n] - pose[e])));
+        }
+        test.Check((std::string(type) + ", " + arm + ": end-effector poses").c_str(), poseError, bound);
+        test.Check((std::string(type) + ", " + arm + ": frames of all joints").c_str(), frameError, bound);
+    }
+
+    template<typename T, int Degree>
+    void TestType(FastTest& test, const char* type, const double bound)
+    {
+        TestArm<T, Degree>(test, type, "UR5 (standard DH)", UR5, FastDhConvention::Standard, bound);
+        TestArm<T, Degree>(test, type, "PUMA 560 (modified DH)", PUMA560, FastDhConvention::Modified, bound);
+    }
+}
+
+int main()
+{
+    FastTest test("FastKinematics");
+    TestType<double, 15>(test, "double/15", 3e-15);
+    TestType<float, 7>(test, "float/7", 8e-6);
+    return test.Result();
+}
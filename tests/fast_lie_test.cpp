@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastLie test added.
+//
+
+// The FastLie test: compares the coefficient functions A, B, C and D, the exponential maps
+// So3Exp() and Se3Exp() and the logarithm maps So3Log() and Se3Log() with the formulas
+// calculated in long double. The angles are random in [0, 3] (across SMALL_THETA, where C and
+// D switch from the polynomials to the direct formulas), tiny (down to 1e-30) and zero, where
+// C and D cancel, and near and at Pi, where the logarithm cannot use sin(theta). The logarithms
+// get the rotations and rigid motions of known rotation vectors and twists: the results are
+// compared with them, and exp of the results (in long double) with the input. Near Pi only the
+// latter is checked, as there the axis of the rounded rotation can have either sign.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_lie_test.cpp -o fast_lie_test
+// ./fast_lie_test
+//
+
+#include "fast_lie.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const std::size_t COUNT{ 1000 };
+    const Real PI{ 3.141592653589793238462643383279502884L };
+
+    // The kinds of test angles.
+    enum class Angles
+    {
+        Random,
+        NearZero,
+        NearPi
+    };
+
+    // n: index of the angle
+    // returns: an angle of the kind @angles: random in [0, 3], 10^-(n % 31) (0 for n = 0) or
+    // Pi - 10^-(n % 16) (Pi for n = 0)
+    Real Angle(std::mt19937_64& generator, const Angles angles, const std::size_t n)
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 3.0);
+        const int exponent = static_cast<int>(n % (angles == Angles::NearZero ? 31 : 16));
+        const Real tiny = std::pow(static_cast<Real>(10), -exponent);
+        return angles == Angles::Random ? static_cast<Real>(uniform(generator)) :
+            angles == Angles::NearZero ? (n == 0 ? 0 : tiny) : (n == 0 ? PI : PI - tiny);
+    }
+
+    // theta: angle
+    // a, b, c, d: return A, B, C and D of @theta (the series where the formulas cancel)
+    void ReferenceCoefficients(const Real theta, Real& a, Real& b, Real& c, Real& d)
+    {
+        const Real z = theta * theta;
+        const Real h = theta / 2;
+        const Real sincHalf = theta == 0 ? 1 : std::sin(h) / h;
+        a = theta == 0 ? 1 : std::sin(theta) / theta;
+        b = sincHalf * sincHalf / 2;
+        c = theta < 0.1L ? static_cast<Real>(1) / 6 - z / 120 + z * z / 5040 - z * z * z / 362880 +
+            z * z * z * z / 39916800 : (theta - std::sin(theta)) / (z * theta);
+        d = theta < 0.1L ? static_cast<Real>(1) / 12 + z / 720 + z * z / 30240 + z * z * z / 1209600 +
+            z * z * z * z / 47900160 : (1 - h * std::cos(h) / std::sin(h)) / z;
+    }
+
+    // w: rotation vector
+    // r: returns exp(w^) (row-major)
+    void ReferenceRotation(const Real w[3], Real r[9])
+    {
+        const Real theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        Real a, b, c, d;
+        ReferenceCoefficients(theta, a, b, c, d);
+        const Real cosTheta = std::cos(theta);
+        for (int row = 0; row < 3; ++row)
+            for (int column = 0; column < 3; ++column)
+                r[3 * row + column] = (row == column ? cosTheta : 0) + b * w[row] * w[column];
+        r[1] -= a * w[2];
+        r[2] += a * w[1];
+        r[3] += a * w[2];
+        r[5] -= a * w[0];
+        r[6] -= a * w[1];
+        r[7] += a * w[0];
+    }
+
+    // rho, w: twist
+    // t: returns V * rho = rho + B * (w x rho) + C * (w x (w x rho))
+    void ReferenceTranslation(const Real rho[3], const Real w[3], Real t[3])
+    {
+        const Real theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        Real a, b, c, d;
+        ReferenceCoefficients(theta, a, b, c, d);
+        const Real cross[3]{ w[1] * rho[2] - w[2] * rho[1], w[2] * rho[0] - w[0] * rho[2],
+            w[0] * rho[1] - w[1] * rho[0] };
+        const Real doubleCross[3]{ w[1] * cross[2] - w[2] * cross[1], w[2] * cross[0] - w[0] * cross[2],
+            w[0] * cross[1] - w[1] * cross[0] };
+        for (int e = 0; e < 3; ++e)
+            t[e] = rho[e] + b * cross[e] + c * doubleCross[e];
+    }
+
+    // out: returns a random rotation vector with the angle @theta
+    void RotationVector(std::mt19937_64& generator, const Real theta, Real out[3])
+    {
+        std::normal_distribution<double> normal;
+        Real norm = 0;
+        for (int e = 0; e < 3; ++e)
+        {
+            out[e] = normal(generator);
+            norm += out[e] * out[e];
+        }
+        for (int e = 0; e < 3; ++e)
+            out[e] *= theta / std::sqrt(norm);
+    }
+
+    // returns: the largest absolute difference of @values to @reference
+    template<typename T>
+    double MaxError(const std::vector<T>& values, const std::vector<Real>& reference)
+    {
+        double error = 0.0;
+        for (std::size_t i = 0; i < values.size(); ++i)
+            error = std::max(error, static_cast<double>(std::abs(values[i] - reference[i])));
+        return error;
+    }
+
+    // returns: the name of the kind of test angles
+    const char* AnglesName(const Angles angles)
+    {
+        return angles == Angles::Random ? "random" : angles == Angles::NearZero ? "near 0" : "near Pi";
+    }
+
+    template<typename T, int Degree>
+    void TestCoefficients(FastTest& test, const char* type, const Angles angles, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::vector<T> theta(COUNT), a(COUNT), b(COUNT), c(COUNT), d(COUNT);
+        std::vector<Real> referenceA(COUNT), referenceB(COUNT), referenceC(COUNT), referenceD(COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            theta[n] = static_cast<T>(Angle(generator, angles, n));
+            ReferenceCoefficients(theta[n], referenceA[n], referenceB[n], referenceC[n], referenceD[n]);
+        }
+        const FastLie<T, Degree> lie;
+        lie.Coefficients(theta.data(), a.data(), b.data(), c.data(), COUNT);
+        lie.LogCoefficient(theta.data(), d.data(), COUNT);
+        // B, C and D are from 0.05 to 0.5 in [0, Pi], so their absolute errors are about the
+        // relative ones. A goes to 0 at Pi, where only its absolute error is meaningful.
+        const std::string name = std::string(type) + ": A, B, C and D, " + AnglesName(angles);
+        test.Check(name.c_str(), std::max({ MaxError(a, referenceA), MaxError(b, referenceB), MaxError(c, referenceC),
+            MaxError(d, referenceD) }), bound);
+    }
+
+    // rotations, translations: @COUNT rigid motions (9 + 3 planes)
+    // twists: @COUNT twists (6 planes)
+    // returns: the largest difference of the rigid motions exp(@twists) (in long double) to the
+    // rigid motions in @rotations and @translations
+    template<typename T>
+    double MaxExpError(const std::vector<T>& rotations, const std::vector<T>& translations,
+        const std::vector<T>& twists)
+    {
+        double error = 0.0;
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            Real rho[3], w[3], r[9], t[3];
+            for (int e = 0; e < 3; ++e)
+            {
+                rho[e] = twists[e * COUNT + n];
+                w[e] = twists[(3 + e) * COUNT + n];
+            }
+            ReferenceRotation(w, r);
+            ReferenceTranslation(rho, w, t);
+            for (int e = 0; e < 9; ++e)
+                error = std::max(error, static_cast<double>(std::abs(r[e] - rotations[e * COUNT + n])));
+            for (int e = 0; e < 3; ++e)
+                error = std::max(error, static_cast<double>(std::abs(t[e] - translations[e * COUNT + n])));
+        }
+        return error;
+    }
+
+    template<typename T, int Degree>
+    void TestMaps(FastTest& test, const char* type, const Angles angles, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-2.0, 2.0);
+        std::vector<T> twists(6 * COUNT), rotations(9 * COUNT), translations(3 * COUNT);
+        std::vector<T> logRotations(9 * COUNT), logTranslations(3 * COUNT);
+        std::vector<Real> exactRotations(9 * COUNT), exactTranslations(3 * COUNT), exactTwists(6 * COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            Real w[3], rho[3];
+            RotationVector(generator, Angle(generator, angles, n), w);
+            for (int e = 0; e < 3; ++e)
+            {
+                rho[e] = uniform(generator);
+                twists[e * COUNT + n] = static_cast<T>(rho[e]);
+                twists[(3 + e) * COUNT + n] = static_cast<T>(w[e]);
+            }
+            // Exp: the reference from the rounded twist.
+            Real roundedW[3], roundedRho[3], r[9], t[3];
+            for (int e = 0; e < 3; ++e)
+            {
+                roundedRho[e] = twists[e * COUNT + n];
+                roundedW[e] = twists[(3 + e) * COUNT + n];
+            }
+            ReferenceRotation(roundedW, r);
+            ReferenceTranslation(roundedRho, roundedW, t);
+            for (int e = 0; e < 9; ++e)
+                exactRotations[e * COUNT + n] = r[e];
+            for (int e = 0; e < 3; ++e)
+                exactTranslations[e * COUNT + n] = t[e];
+            // Log: the rigid motion of the exact twist, rounded, has to give the twist back.
+            ReferenceRotation(w, r);
+            ReferenceTranslation(rho, w, t);
+            for (int e = 0; e < 9; ++e)
+                logRotations[e * COUNT + n] = static_cast<T>(r[e]);
+            for (int e = 0; e < 3; ++e)
+            {
+                logTranslations[e * COUNT + n] = static_cast<T>(t[e]);
+                exactTwists[e * COUNT + n] = rho[e];
+                exactTwists[(3 + e) * COUNT + n] = w[e];
+            }
+        }
+        const FastLie<T, Degree> lie;
+        std::vector<T> so3Rotations(9 * COUNT), rotationVectors(3 * COUNT), logTwists(6 * COUNT);
+        lie.So3Exp(twists.data() + 3 * COUNT, so3Rotations.data(), COUNT);
+        lie.Se3Exp(twists.data(), rotations.data(), translations.data(), COUNT);
+        lie.So3Log(logRotations.data(), rotationVectors.data(), COUNT);
+        lie.Se3Log(logRotations.data(), logTranslations.data(), logTwists.data(), COUNT);
+        const std::string name = std::string(type) + ": ";
+        const char* const kind = AnglesName(angles);
+        test.Check((name + "So3Exp, " + kind).c_str(), MaxError(so3Rotations, exactRotations), bound);
+        test.Check((name + "Se3Exp, " + kind).c_str(), std::max(MaxError(rotations, exactRotations),
+            MaxError(translations, exactTranslations)), bound);
+        if (angles != Angles::NearPi)
+        {
+            const std::vector<Real> exactRotationVectors(exactTwists.begin() + 3 * COUNT, exactTwists.end());
+            test.Check((name + "So3Log, " + kind).c_str(), MaxError(rotationVectors, exactRotationVectors), bound);
+            test.Check((name + "Se3Log, " + kind).c_str(), MaxError(logTwists, exactTwists), bound);
+        }
+        // exp(So3Log(R)) = R: the twists with rho = 0 (the translations are then 0 too).
+        std::vector<T> so3Twists(6 * COUNT, static_cast<T>(0.0));
+        std::copy(rotationVectors.begin(), rotationVectors.end(), so3Twists.begin() + 3 * COUNT);
+        test.Check((name + "exp(So3Log), " + kind).c_str(), MaxExpError(logRotations,
+            std::vector<T>(3 * COUNT, static_cast<T>(0.0)), so3Twists), bound);
+        test.Check((name + "exp(Se3Log), " + kind).c_str(), MaxExpError(logRotations, logTranslations, logTwists),
+            bound);
+    }
+
+    // sinError: the maximum error of FastSin<T, Degree>
+    // The coefficients and the maps add up a few errors of the half angle sine and cosine and
+    // a few roundings.
+    template<typename T, int Degree>
+    void TestType(FastTest& test, const char* type, const double sinError)
+    {
+        const double bound = 4.0 * sinError + 8.0 * std::numeric_limits<T>::epsilon();
+        for (const Angles angles : { Angles::Random, Angles::NearZero, Angles::NearPi })
+        {
+            TestCoefficients<T, Degree>(test, type, angles, bound);
+            TestMaps<T, Degree>(test, type, angles, bound);
+        }
+    }
+}
+
+int main()
+{
+    FastTest test("FastLie");
+    TestType<double, 15>(test, "double/15", 4.19641e-16);
+    TestType<float, 7>(test, "float/7", 9.39102e-07);
+    return test.Result();
+}
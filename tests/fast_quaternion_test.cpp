@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastQuaternion test added.
+//
+
+// The FastQuaternion test: compares Slerp(), FromAxisAngle() and Exp() with the formulas
+// calculated in long double. Slerp is checked with random pairs, pairs in opposite hemispheres
+// (the shorter way), nearly equal and equal pairs (the sin(x)/x form and its epsilon clamp) and
+// the ends t = 0 and t = 1. Exp is checked with random rotation vectors and with tiny and zero
+// ones (the clamp of the half angle).
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_quaternion_test.cpp -o fast_quaternion_test
+// ./fast_quaternion_test
+//
+
+#include "fast_quaternion.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const std::size_t COUNT{ 1000 };
+
+    // out: returns a random unit quaternion (w, x, y, z)
+    void RandomQuaternion(std::mt19937_64& generator, Real out[4])
+    {
+        std::normal_distribution<double> normal;
+        Real norm = 0;
+        for (int e = 0; e < 4; ++e)
+        {
+            out[e] = normal(generator);
+            norm += out[e] * out[e];
+        }
+        for (int e = 0; e < 4; ++e)
+            out[e] /= std::sqrt(norm);
+    }
+
+    // returns: the largest difference of the quaternions in @planes to @reference (both @COUNT
+    // quaternions in planes)
+    template<typename T>
+    double MaxError(const std::vector<T>& planes, const std::vector<Real>& reference)
+    {
+        double error = 0.0;
+        for (std::size_t i = 0; i < planes.size(); ++i)
+            error = std::max(error, static_cast<double>(std::abs(planes[i] - reference[i])));
+        return error;
+    }
+
+    // The kinds of Slerp pairs: the angle between q0 and q1 (or -q1).
+    enum class Pairs
+    {
+        Random,
+        OppositeHemisphere,
+        Near,
+        Equal
+    };
+
+    template<typename T, int Degree>
+    void TestSlerp(FastTest& test, const char* type, const Pairs pairs, const char* name, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<T> q0(4 * COUNT), q1(4 * COUNT), t(COUNT), out(4 * COUNT);
+        std::vector<Real> reference(4 * COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            Real a[4], b[4];
+            RandomQuaternion(generator, a);
+            RandomQuaternion(generator, b);
+            if (pairs != Pairs::Random)
+            {
+                // b = a moved by a small angle (0 for Equal) and, for OppositeHemisphere, negated
+                const Real scale = pairs == Pairs::Near ?
+                    std::pow(static_cast<Real>(10), -1 - static_cast<int>(n % 8)) :
+                    pairs == Pairs::Equal ? 0 : static_cast<Real>(0.5);
+                const Real sign = pairs == Pairs::OppositeHemisphere ? -1 : 1;
+                Real norm = 0;
+                for (int e = 0; e < 4; ++e)
+                {
+                    b[e] = a[e] + scale * b[e];
+                    norm += b[e] * b[e];
+                }
+                for (int e = 0; e < 4; ++e)
+                    b[e] = sign * b[e] / std::sqrt(norm);
+            }
+            // The ends are included: t = 0 and t = 1 must give q0 and (+-)q1.
+            t[n] = n % 10 == 0 ? static_cast<T>(0.0) : n % 10 == 1 ? static_cast<T>(1.0) :
+                static_cast<T>(uniform(generator));
+            for (int e = 0; e < 4; ++e)
+            {
+                q0[e * COUNT + n] = static_cast<T>(a[e]);
+                q1[e * COUNT + n] = static_cast<T>(b[e]);
+            }
+            // The reference from the rounded inputs.
+            Real dot = 0;
+            for (int e = 0; e < 4; ++e)
+                dot += static_cast<Real>(q0[e * COUNT + n]) * q1[e * COUNT + n];
+            const Real sign = dot < 0 ? -1 : 1;
+            const Real theta = std::acos(std::min(sign * dot, static_cast<Real>(1)));
+            const Real tn = t[n];
+            const Real weight0 = theta < 1e-30L ? 1 - tn : std::sin((1 - tn) * theta) / std::sin(theta);
+            const Real weight1 = sign * (theta < 1e-30L ? tn : std::sin(tn * theta) / std::sin(theta));
+            for (int e = 0; e < 4; ++e)
+                reference[e * COUNT + n] = weight0 * q0[e * COUNT + n] + weight1 * q1[e * COUNT + n];
+        }
+        const FastQuaternion<T, Degree> quaternion;
+        quaternion.Slerp(q0.data(), q1.data(), t.data(), out.data(), COUNT);
+        test.Check((std::string(type) + ": Slerp, " + name).c_str(), MaxError(out, reference), bound);
+    }
+
+    template<typename T, int Degree>
+    void TestExp(FastTest& test, const char* type, const double bound)
+    {
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(-4.0, 4.0);
+        std::vector<T> vectors(3 * COUNT), axes(3 * COUNT), angles(COUNT), out(4 * COUNT), axisAngleOut(4 * COUNT);
+        std::vector<Real> reference(4 * COUNT), axisAngleReference(4 * COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            // Every 4th vector is tiny (down to 1e-30) and the first one is zero.
+            const Real scale = n == 0 ? 0 : n % 4 == 0 ? std::pow(static_cast<Real>(10), -static_cast<int>(n % 31)) : 1;
+            Real angle = 0;
+            for (int e = 0; e < 3; ++e)
+            {
+                vectors[e * COUNT + n] = static_cast<T>(scale * uniform(generator));
+                angle += static_cast<Real>(vectors[e * COUNT + n]) * vectors[e * COUNT + n];
+            }
+            angle = std::sqrt(angle);
+            // sin(angle / 2) / angle, 1/2 in the limit
+            const Real scaleSin = angle < 1e-30L ? static_cast<Real>(0.5) : std::sin(angle / 2) / angle;
+            reference[n] = std::cos(angle / 2);
+            for (int e = 0; e < 3; ++e)
+                reference[(e + 1) * COUNT + n] = scaleSin * vectors[e * COUNT + n];
+
+            // FromAxisAngle: a unit axis and an angle in [-4, 4].
+            Real axis[4];
+            RandomQuaternion(generator, axis);
+            const Real norm = std::sqrt(axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3]);
+            for (int e = 0; e < 3; ++e)
+                axes[e * COUNT + n] = static_cast<T>(axis[e + 1] / norm);
+            angles[n] = static_cast<T>(uniform(generator));
+            const Real halfAngle = static_cast<Real>(angles[n]) / 2;
+            axisAngleReference[n] = std::cos(halfAngle);
+            for (int e = 0; e < 3; ++e)
+                axisAngleReference[(e + 1) * COUNT + n] = std::sin(halfAngle) * axes[e * COUNT + n];
+        }
+        const FastQuaternion<T, Degree> quaternion;
+        quaternion.Exp(vectors.data(), out.data(), COUNT);
+        test.Check((std::string(type) + ": Exp, random, tiny and zero").c_str(), MaxError(out, reference), bound);
+        quaternion.FromAxisAngle(axes.data(), angles.data(), axisAngleOut.data(), COUNT);
+        test.Check((std::string(type) + ": FromAxisAngle").c_str(), MaxError(axisAngleOut, axisAngleReference), bound);
+    }
+
+    template<typename T, int Degree>
+    void TestType(FastTest& test, const char* type, const double bound)
+    {
+        TestSlerp<T, Degree>(test, type, Pairs::Random, "random", bound);
+        TestSlerp<T, Degree>(test, type, Pairs::OppositeHemisphere, "opposite hemisphere", bound);
+        TestSlerp<T, Degree>(test, type, Pairs::Near, "near (1e-1 to 1e-8)", bound);
+        TestSlerp<T, Degree>(test, type, Pairs::Equal, "equal", bound);
+        TestExp<T, Degree>(test, type, bound);
+    }
+}
+
+int main()
+{
+    FastTest test("FastQuaternion");
+    TestType<double, 15>(test, "double/15", 2e-15);
+    TestType<float, 7>(test, "float/7", 4e-6);
+    return test.Result();
+}
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+// Version info
+// 17/10/26: First version. The FastSphericalHarmonics test added.
+//
+
+// The FastSphericalHarmonics test: compares the harmonics up to L = 4 and L = 20 with
+// K_lm * P_lm(cos(theta)) * cos(m * phi) (or sin) calculated in long double, with P_lm from
+// std::assoc_legendre (which has no Condon-Shortley phase, like the default) and the
+// factorials from std::tgamma. This checks the recurrences in l and the powers of x + iy against
+// the closed form. The phase option and the poles (theta = 0 and Pi) are checked too.
+//   The error of cos(theta) from FastSinCos is amplified by the slope of the harmonics, which is
+// largest for Y_L0 at the poles: sqrt((2L + 1) / (4 * Pi)) * L * (L + 1) / 2. So the bound is
+// twice the FastSin error (plus the rounding of T) times 1 + that slope.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_spherical_harmonics_test.cpp -o fast_spherical_harmonics_test
+// ./fast_spherical_harmonics_test
+//
+
+#include "fast_spherical_harmonics.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const Real PI{ 3.141592653589793238462643383279502884L };
+    const std::size_t COUNT{ 1000 };
+
+    // returns: the real spherical harmonic Y_lm(@theta, @phi) without the Condon-Shortley phase
+    Real Harmonic(const int l, const int m, const Real theta, const Real phi)
+    {
+        const int absM = m < 0 ? -m : m;
+        const Real k = std::sqrt((2 * l + 1) / (4 * PI) * std::tgamma(static_cast<Real>(l - absM + 1)) /
+            std::tgamma(static_cast<Real>(l + absM + 1)));
+        const Real legendre = std::assoc_legendre(static_cast<unsigned>(l), static_cast<unsigned>(absM),
+            std::cos(theta));
+        if (m == 0)
+            return k * legendre;
+        return std::sqrt(static_cast<Real>(2)) * k * legendre * (m > 0 ? std::cos(m * phi) : std::sin(absM * phi));
+    }
+
+    // sinError: the maximum error of FastSinCos<T, Degree>, plus the rounding of T
+    template<int L, typename T, int Degree>
+    void TestOrder(FastTest& test, const char* type, const bool condonShortleyPhase, const double sinError)
+    {
+        const double slope = std::sqrt((2.0 * L + 1.0) / (4.0 * 3.141592653589793)) * L * (L + 1) / 2.0;
+        const double bound = 2.0 * sinError * (1.0 + slope);
+        std::mt19937_64 generator(2026);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<T> theta(COUNT), phi(COUNT);
+        for (std::size_t n = 0; n < COUNT; ++n)
+        {
+            // Uniform directions, and the poles.
+            theta[n] = static_cast<T>(n == 0 ? 0.0 : n == 1 ? PI : std::acos(1.0 - 2.0 * uniform(generator)));
+            phi[n] = static_cast<T>(2.0 * PI * uniform(generator) - PI);
+        }
+        const FastSphericalHarmonics<L, T, Degree> harmonics(condonShortleyPhase);
+        const int coefficients = FastSphericalHarmonics<L, T, Degree>::COEFFICIENTS;
+        std::vector<T> out(static_cast<std::size_t>(coefficients) * COUNT);
+        harmonics(theta.data(), phi.data(), out.data(), COUNT);
+        double error = 0.0;
+        for (int l = 0; l <= L; ++l)
+        {
+            for (int m = -l; m <= l; ++m)
+            {
+                const Real sign = condonShortleyPhase && m % 2 != 0 ? -1 : 1;
+                const T* const plane = out.data() + static_cast<std::size_t>(l * (l + 1) + m) * COUNT;
+                for (std::size_t n = 0; n < COUNT; ++n)
+                {
+                    const Real reference = sign * Harmonic(l, m, theta[n], phi[n]);
+                    error = std::max(error, static_cast<double>(std::abs(plane[n] - reference)));
+                }
+            }
+        }
+        test.Check((std::string(type) + ", L = " + std::to_string(L) +
+            (condonShortleyPhase ? ", Condon-Shortley phase" : "")).c_str(), error, bound);
+    }
+}
+
+int main()
+{
+    FastTest test("FastSphericalHarmonics");
+    const double doubleError = 4.2e-16, floatError = 9.4e-7 + 6e-8;
+    TestOrder<4, double, 15>(test, "double/15", false, doubleError);
+    TestOrder<4, double, 15>(test, "double/15", true, doubleError);
+    TestOrder<20, double, 15>(test, "double/15", false, doubleError);
+    TestOrder<4, float, 7>(test, "float/7", false, floatError);
+    TestOrder<4, float, 7>(test, "float/7", true, floatError);
+    TestOrder<20, float, 7>(test, "float/7", false, floatError);
+    return test.Result();
+}
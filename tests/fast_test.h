@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. class FastTest added.
+//
+
+#ifndef __FAST_TEST__
+#define __FAST_TEST__
+
+#include <cstdio>
+
+// FastTest: The checks of the behavior tests (tests/*_test.cpp). Each check prints one line,
+// and a failed check is marked and makes Result() return 1, the exit code of the test.
+//
+// Usage example:
+// FastTest test("FastTwiddles");
+// test.Check("Split, N = 1024", maxError, 1e-15);
+// test.Expect("Radix4 throws for N = 6", hasThrown);
+// return test.Result();
+//
+class FastTest
+{
+public:
+    // name: the tested class, printed at the start and at the end
+    explicit FastTest(const char* name);
+
+    // what: the checked case
+    // error, bound: the measured error must be at most @bound
+    void Check(const char* what, double error, double bound);
+
+    // what: the checked case
+    // condition: must be true
+    void Expect(const char* what, bool condition);
+
+    // returns: 0 if all the checks passed, otherwise 1
+    int Result() const;
+
+private:
+    const char* m_name;
+    int m_checks{ 0 };
+    int m_failures{ 0 };
+};
+
+inline FastTest::FastTest(const char* const name) :
+    m_name{ name }
+{
+    std::printf("%s\n", m_name);
+}
+
+inline void FastTest::Check(const char* const what, const double error, const double bound)
+{
+    // Written so that a NaN error fails.
+    const bool isFailure = !(error <= bound);
+    ++m_checks;
+    m_failures += isFailure ? 1 : 0;
+    std::printf("  %-58s %.5e  (bound %.5e)%s\n", what, error, bound, isFailure ? "  FAILED" : "");
+}
+
+inline void FastTest::Expect(const char* const what, const bool condition)
+{
+    ++m_checks;
+    m_failures += condition ? 0 : 1;
+    std::printf("  %-58s %s\n", what, condition ? "ok" : "FAILED");
+}
+
+inline int FastTest::Result() const
+{
+    std::printf("%s: %d of %d checks failed.\n", m_name, m_failures, m_checks);
+    return m_failures == 0 ? 0 : 1;
+}
+
+#endif // __FAST_TEST__
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+//
+// Copyright (c) 2021 Juha Kettunen
+// Contact: cpekkak ( at ) gmail.com
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+// Version info
+// 17/10/26: First version. The FastTwiddles test added.
+//
+
+// The FastTwiddles test: compares the Interleaved(), Split(), Radix4() and Twiddle() output
+// with cos and sin of 2*Pi*k/N in long double, forward and inverse, for N divisible by 8, by 4
+// only, by 2 only and odd (each uses a different symmetry), and checks the invalid arguments.
+//
+// Build and run (from the repository root):
+// g++ -std=c++17 -O2 -I. tests/fast_twiddle_test.cpp -o fast_twiddle_test
+// ./fast_twiddle_test
+//
+
+#include "fast_twiddle.h"
+#include "fast_test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef long double Real;
+
+    const Real PI{ 3.141592653589793238462643383279502884L };
+
+    // returns: the larger of the errors of @re and @im against W^k of size @n
+    double TwiddleError(const std::size_t n, const bool inverse, const std::size_t k, const Real re, const Real im)
+    {
+        const Real angle = 2 * PI * static_cast<Real>(k % n) / static_cast<Real>(n);
+        const Real sign = inverse ? 1 : -1;
+        return static_cast<double>(std::max(std::abs(re - std::cos(angle)), std::abs(im - sign * std::sin(angle))));
+    }
+
+    template<typename T, int Degree>
+    void TestSize(FastTest& test, const char* type, const std::size_t n, const double bound)
+    {
+        for (const bool inverse : { false, true })
+        {
+            const FastTwiddles<T, Degree> twiddles(n, inverse);
+            std::vector<T> interleaved(2 * n), re(n), im(n);
+            twiddles.Interleaved(interleaved.data(), n);
+            twiddles.Split(re.data(), im.data(), n);
+            double interleavedError = 0.0, splitError = 0.0, twiddleError = 0.0;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                interleavedError = std::max(interleavedError, TwiddleError(n, inverse, k, interleaved[2 * k],
+                    interleaved[2 * k + 1]));
+                splitError = std::max(splitError, TwiddleError(n, inverse, k, re[k], im[k]));
+                // Twiddle() with an index beyond N must give W^(k mod N).
+                T reValue, imValue;
+                twiddles.Twiddle(k + 3 * n, reValue, imValue);
+                twiddleError = std::max(twiddleError, TwiddleError(n, inverse, k, reValue, imValue));
+            }
+            const std::string prefix = std::string(type) + ", N = " + std::to_string(n) +
+                (inverse ? ", inverse" : ", forward");
+            test.Check((prefix + ": Interleaved").c_str(), interleavedError, bound);
+            test.Check((prefix + ": Split").c_str(), splitError, bound);
+            test.Check((prefix + ": Twiddle(k + 3N)").c_str(), twiddleError, bound);
+            if (n % 4 == 0)
+            {
+                std::vector<T> radix4(6 * (n / 4));
+                twiddles.Radix4(radix4.data());
+                double radix4Error = 0.0;
+                for (std::size_t k = 0; k < n / 4; ++k)
+                {
+                    for (std::size_t m = 1; m <= 3; ++m)
+                        radix4Error = std::max(radix4Error, TwiddleError(n, inverse, m * k, radix4[6 * k + 2 * m - 2],
+                            radix4[6 * k + 2 * m - 1]));
+                }
+                test.Check((prefix + ": Radix4").c_str(), radix4Error, bound);
+            }
+            // A shorter table is the start of the full one.
+            const std::size_t count = n / 3;
+            std::vector<T> shortRe(count), shortIm(count);
+            twiddles.Split(shortRe.data(), shortIm.data(), count);
+            test.Expect((prefix + ": Split of N/3 is the start").c_str(),
+                std::equal(shortRe.begin(), shortRe.end(), re.begin()) &&
+                std::equal(shortIm.begin(), shortIm.end(), im.begin()));
+        }
+    }
+
+    template<typename Func>
+    bool Throws(Func func)
+    {
+        try
+        {
+            func();
+        }
+        catch (const std::logic_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main()
+{
+    FastTest test("FastTwiddles");
+    // N divisible by 8, by 4 only, by 2 only and odd.
+    const std::size_t sizes[]{ 1, 2, 3, 6, 7, 12, 36, 1000, 1020, 1022, 1023, 1024, 4096, 65536 };
+    for (const std::size_t n : sizes)
+    {
+        TestSize<double, 15>(test, "double/15", n, 1e-15);
+        TestSize<float, 7>(test, "float/7", n, 2.5e-6);
+    }
+
+    const FastTwiddles<double, 15> twiddles(6);
+    std::vector<double> out(2 * 7);
+    test.Expect("FastTwiddles(0) throws", Throws([]() { FastTwiddles<double, 15> empty(0); }));
+    test.Expect("Interleaved with count > N throws", Throws([&]() { twiddles.Interleaved(out.data(), 7); }));
+    test.Expect("Split with count > N throws", Throws([&]() { twiddles.Split(out.data(), out.data() + 7, 7); }));
+    test.Expect("Radix4 with N = 6 throws", Throws([&]() { twiddles.Radix4(out.data()); }));
+    return test.Result();
+}